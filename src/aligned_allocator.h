@@ -0,0 +1,185 @@
+#ifndef ALIGNED_ALLOCATOR_HH
+#define ALIGNED_ALLOCATOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// POSIX includes
+#include <sys/mman.h>
+
+#include "growth_policy.h"
+
+namespace kt
+{
+inline constexpr std::size_t cache_line_size{ 64 };
+inline constexpr std::size_t page_size{ 4096 };
+inline constexpr std::size_t huge_page_size{ 2 * 1024 * 1024 };
+
+///
+/// Allocator whose blocks start at a multiple of "Alignment" bytes, for
+/// instance 32 or 64 so every AVX load of a kt::vector<float> starting at
+/// an aligned index stays within one cache line, or page_size. Uses the
+/// aligned operator new, the memory comes from the global heap
+///
+template <typename T, std::size_t Alignment = cache_line_size>
+class aligned_allocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "the alignment has to be a power of two");
+    static_assert(Alignment >= alignof(T), "the alignment cannot be weaker than the one of the type");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment{ Alignment };
+
+    template <typename U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, (Alignment > alignof(U) ? Alignment : alignof(U))>;
+    };
+
+    aligned_allocator() noexcept = default;
+
+    template <typename U, std::size_t OtherAlignment>
+    aligned_allocator(const aligned_allocator<U, OtherAlignment>&) noexcept { }
+
+    ///
+    /// Returns a block for "count" elements, throws std::bad_alloc if there is no memory
+    ///
+    auto allocate(std::size_t count) -> T*
+    {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_alloc{};
+
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    auto deallocate(T* block, std::size_t count) noexcept -> void
+    {
+        ::operator delete(static_cast<void*>(block), count * sizeof(T), std::align_val_t{ Alignment });
+    }
+};
+
+template <typename T, std::size_t A, typename U, std::size_t B>
+auto operator==(const aligned_allocator<T, A>&, const aligned_allocator<U, B>&) noexcept -> bool
+{
+    return true;
+}
+
+template <typename T, std::size_t A, typename U, std::size_t B>
+auto operator!=(const aligned_allocator<T, A>&, const aligned_allocator<U, B>&) noexcept -> bool
+{
+    return false;
+}
+
+///
+/// Aligned allocator for large tables. Blocks smaller than "Threshold" bytes
+/// come from the aligned operator new like aligned_allocator; bigger ones get
+/// their own anonymous mapping aligned to and rounded up to huge_page_size and
+/// marked with MADV_HUGEPAGE, so the kernel backs them with transparent huge
+/// pages and a scan over gigabytes needs 512 times fewer TLB entries.
+///
+/// Pair it with grow_page_rounded<huge_page_size> so the capacity of a
+/// vector grows into the whole mapping instead of wasting its tail
+///
+template <typename T, std::size_t Alignment = cache_line_size, std::size_t Threshold = huge_page_size>
+class huge_page_allocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "the alignment has to be a power of two");
+    static_assert(Alignment >= alignof(T), "the alignment cannot be weaker than the one of the type");
+    static_assert(Alignment <= huge_page_size, "mappings are only aligned to huge_page_size");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment{ Alignment };
+    static constexpr std::size_t threshold{ Threshold };
+
+    template <typename U>
+    struct rebind
+    {
+        using other = huge_page_allocator<U, (Alignment > alignof(U) ? Alignment : alignof(U)), Threshold>;
+    };
+
+    huge_page_allocator() noexcept = default;
+
+    template <typename U, std::size_t OtherAlignment>
+    huge_page_allocator(const huge_page_allocator<U, OtherAlignment, Threshold>&) noexcept { }
+
+    ///
+    /// Returns a block for "count" elements, throws std::bad_alloc if there is no memory
+    ///
+    auto allocate(std::size_t count) -> T*
+    {
+        if (count > (static_cast<std::size_t>(-1) - huge_page_size) / sizeof(T))
+            throw std::bad_alloc{};
+
+        const std::size_t bytes{ count * sizeof(T) };
+
+        if (bytes < Threshold)
+            return static_cast<T*>(::operator new(bytes, std::align_val_t{ Alignment }));
+
+        return static_cast<T*>(map_huge(detail::round_up(bytes, huge_page_size)));
+    }
+
+    auto deallocate(T* block, std::size_t count) noexcept -> void
+    {
+        const std::size_t bytes{ count * sizeof(T) };
+
+        if (bytes < Threshold)
+            ::operator delete(static_cast<void*>(block), bytes, std::align_val_t{ Alignment });
+        else
+            ::munmap(static_cast<void*>(block), detail::round_up(bytes, huge_page_size));
+    }
+
+private:
+    ///
+    /// Maps "bytes" plus one huge page and unmaps the unaligned head and
+    /// tail, the kernel can only use huge pages for aligned ranges
+    ///
+    static auto map_huge(std::size_t bytes) -> void*
+    {
+        const std::size_t mapped_bytes{ bytes + huge_page_size };
+        void* const mapping{ ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+
+        if (mapping == MAP_FAILED)
+            throw std::bad_alloc{};
+
+        const auto start{ reinterpret_cast<std::uintptr_t>(mapping) };
+        const std::uintptr_t aligned{ detail::round_up(start, huge_page_size) };
+
+        if (aligned != start)
+            ::munmap(mapping, aligned - start);
+
+        if (const std::size_t tail{ start + mapped_bytes - (aligned + bytes) }; tail != 0)
+            ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+
+#if defined(MADV_HUGEPAGE)
+        // only a hint, without transparent huge pages the mapping still works with small pages
+        ::madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE);
+#endif
+
+        return reinterpret_cast<void*>(aligned);
+    }
+};
+
+template <typename T, std::size_t A, std::size_t N, typename U, std::size_t B, std::size_t M>
+auto operator==(const huge_page_allocator<T, A, N>&, const huge_page_allocator<U, B, M>&) noexcept -> bool
+{
+    return N == M;
+}
+
+template <typename T, std::size_t A, std::size_t N, typename U, std::size_t B, std::size_t M>
+auto operator!=(const huge_page_allocator<T, A, N>&, const huge_page_allocator<U, B, M>&) noexcept -> bool
+{
+    return N != M;
+}
+
+}   // END KT NAMESPACE
+
+#endif
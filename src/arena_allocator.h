@@ -0,0 +1,229 @@
+#ifndef ARENA_ALLOCATOR_HH
+#define ARENA_ALLOCATOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace kt
+{
+///
+/// Monotonic arena. Memory is handed out by bumping a pointer inside
+/// large chunks, deallocation of individual blocks is a no-op and every
+/// block obtained from the arena is released at once with reset()
+///
+class arena
+{
+public:
+    static constexpr std::size_t default_chunk_size{ 64 * 1024 };
+    static constexpr std::size_t max_chunk_size{ 64 * 1024 * 1024 };
+
+    ///
+    /// Creates an empty arena. No memory is requested until the first allocation
+    ///
+    explicit arena(std::size_t chunk_size = default_chunk_size)
+        :   m_head{ nullptr }, m_cursor{ nullptr }, m_end{ nullptr },
+            m_next_chunk_size{ chunk_size ? chunk_size : default_chunk_size }, m_bytes_allocated{}
+    {
+
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ///
+    /// Destructor. Returns every chunk to the global heap
+    ///
+    ~arena()
+    {
+        release();
+    }
+
+    ///
+    /// Returns a block of at least "bytes" bytes aligned to "alignment".
+    /// Throws std::bad_alloc if a new chunk could not be obtained
+    ///
+    auto allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) -> void*
+    {
+        std::byte* block{ align_up(this->m_cursor, alignment) };
+
+        if (not this->m_cursor or block + bytes > this->m_end)
+        {
+            add_chunk(bytes + alignment);
+            block = align_up(this->m_cursor, alignment);
+        }
+
+        this->m_cursor = block + bytes;
+        this->m_bytes_allocated += bytes;
+
+        return static_cast<void*>(block);
+    }
+
+    ///
+    /// Individual blocks are never given back, they live until reset() or release()
+    ///
+    auto deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) noexcept -> void
+    {
+
+    }
+
+    ///
+    /// Invalidates every block handed out so far. The most recent (and largest)
+    /// chunk is kept so the next round of allocations does not touch the heap
+    ///
+    auto reset() noexcept -> void
+    {
+        if (not this->m_head)
+            return;
+
+        free_chunks(this->m_head->next);
+        this->m_head->next = nullptr;
+
+        this->m_cursor = chunk_begin(this->m_head);
+        this->m_end = this->m_cursor + this->m_head->size;
+        this->m_bytes_allocated = 0;
+    }
+
+    ///
+    /// Invalidates every block handed out so far and gives all the chunks back
+    ///
+    auto release() noexcept -> void
+    {
+        free_chunks(this->m_head);
+
+        this->m_head = nullptr;
+        this->m_cursor = nullptr;
+        this->m_end = nullptr;
+        this->m_bytes_allocated = 0;
+    }
+
+    ///
+    /// Amount of bytes handed out since the last reset
+    ///
+    auto bytes_allocated() const noexcept -> std::size_t
+    {
+        return this->m_bytes_allocated;
+    }
+
+private:
+    struct chunk_header
+    {
+        chunk_header* next;
+        std::size_t size;
+    };
+
+    static auto align_up(std::byte* ptr, std::size_t alignment) noexcept -> std::byte*
+    {
+        auto address{ reinterpret_cast<std::uintptr_t>(ptr) };
+        address = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+        return reinterpret_cast<std::byte*>(address);
+    }
+
+    static auto chunk_begin(chunk_header* chunk) noexcept -> std::byte*
+    {
+        return reinterpret_cast<std::byte*>(chunk + 1);
+    }
+
+    static auto free_chunks(chunk_header* chunk) noexcept -> void
+    {
+        while (chunk)
+        {
+            chunk_header* next{ chunk->next };
+            ::operator delete(static_cast<void*>(chunk));
+            chunk = next;
+        }
+    }
+
+    auto add_chunk(std::size_t min_bytes) -> void
+    {
+        std::size_t chunk_size{ this->m_next_chunk_size };
+
+        while (chunk_size < min_bytes)
+            chunk_size *= 2;
+
+        auto chunk{ static_cast<chunk_header*>(::operator new(sizeof(chunk_header) + chunk_size)) };
+        chunk->next = this->m_head;
+        chunk->size = chunk_size;
+
+        this->m_head = chunk;
+        this->m_cursor = chunk_begin(chunk);
+        this->m_end = this->m_cursor + chunk_size;
+
+        // chunks grow geometrically so big requests need few of them
+        if (this->m_next_chunk_size < max_chunk_size)
+            this->m_next_chunk_size *= 2;
+    }
+
+    chunk_header* m_head;
+    std::byte* m_cursor;
+    std::byte* m_end;
+    std::size_t m_next_chunk_size;
+    std::size_t m_bytes_allocated;
+};
+
+///
+/// Standard allocator adaptor over kt::arena. Containers using it
+/// never free memory on their own, the owning arena does in one go
+///
+template <typename T>
+class arena_allocator
+{
+public:
+    using value_type = T;
+
+    // copies stay in the arena of the source container, moves and swaps carry the arena along
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    explicit arena_allocator(arena& source) noexcept
+        :   m_arena{ &source }
+    {
+
+    }
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        :   m_arena{ other.resource() }
+    {
+
+    }
+
+    auto allocate(std::size_t count) -> T*
+    {
+        return static_cast<T*>(this->m_arena->allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    auto deallocate(T* block, std::size_t count) noexcept -> void
+    {
+        this->m_arena->deallocate(static_cast<void*>(block), sizeof(T) * count, alignof(T));
+    }
+
+    auto resource() const noexcept -> arena*
+    {
+        return this->m_arena;
+    }
+
+private:
+    arena* m_arena;
+};
+
+template <typename T, typename U>
+auto operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept -> bool
+{
+    return lhs.resource() == rhs.resource();
+}
+
+template <typename T, typename U>
+auto operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept -> bool
+{
+    return not (lhs == rhs);
+}
+
+}   // END KT NAMESPACE
+
+#endif
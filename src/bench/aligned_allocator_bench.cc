@@ -0,0 +1,80 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../simd.h"
+#include "../aligned_allocator.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+template <typename Vector>
+struct scan_result
+{
+    std::uintptr_t misalignment;
+    double sum_ns;
+    double gather_ns;
+};
+
+// "count" floats, then a SIMD sum over all of them and a sum over "count" / 8 random elements
+template <typename Vector>
+auto measure(std::size_t count) -> scan_result<Vector>
+{
+    Vector values{};
+    values.resize_default_init(count);
+    kt::simd::fill(values.data(), count, 1.0f);
+
+    const double sum_ns{ bench::time_ns(5, [&values, count]() -> void
+    {
+        bench::do_not_optimize(kt::simd::sum(values.data(), count));
+    }) / static_cast<double>(count) };
+
+    const std::size_t gathers{ count / 8 };
+    const double gather_ns{ bench::time_ns(1, [&values, count, gathers]() -> void
+    {
+        std::uint64_t state{ 0x9E3779B97F4A7C15ull };
+        float total{};
+
+        for (std::size_t index{}; index < gathers; ++index)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            total += values[state % count];
+        }
+
+        bench::do_not_optimize(total);
+    }) / static_cast<double>(gathers) };
+
+    return { reinterpret_cast<std::uintptr_t>(values.data()) % kt::cache_line_size, sum_ns, gather_ns };
+}
+
+template <typename Vector>
+auto report(const char* name, std::size_t count) -> void
+{
+    const scan_result<Vector> result{ measure<Vector>(count) };
+
+    std::printf("%-34s %14zu %12.3f %14.3f\n", name, static_cast<std::size_t>(result.misalignment), result.sum_ns,
+        result.gather_ns);
+}
+
+///
+/// Usage: aligned_allocator_bench [MiB]. Sums a table of floats, 512 MiB by
+/// default, with the SIMD kernels and reads random elements of it, once per
+/// allocator. Random reads over a big table are dominated by TLB misses,
+/// which huge pages cut down
+///
+int main(int argc, char** argv)
+{
+    const std::size_t mebibytes{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512 };
+    const std::size_t count{ mebibytes * 1024 * 1024 / sizeof(float) };
+
+    std::printf("%zu MiB of floats, ns per element\n\n", mebibytes);
+    std::printf("%-34s %14s %12s %14s\n", "allocator", "offset in line", "simd sum", "random read");
+
+    report<kt::vector<float>>("std::allocator", count);
+    report<kt::vector<float, kt::aligned_allocator<float, 64>>>("aligned_allocator<64>", count);
+    report<kt::vector<float, kt::huge_page_allocator<float>, kt::grow_page_rounded<kt::huge_page_size>>>(
+        "huge_page_allocator", count);
+
+    return 0;
+}
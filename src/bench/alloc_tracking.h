@@ -0,0 +1,128 @@
+#ifndef ALLOC_TRACKING_HH
+#define ALLOC_TRACKING_HH
+
+// Replaces the global allocation functions to count heap traffic.
+// Include from exactly one translation unit of a benchmark binary
+
+// C++ standard library includes
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+
+#include <malloc.h>
+
+namespace bench
+{
+struct alloc_stats
+{
+    std::size_t allocations;
+    std::size_t bytes_in_use;
+    std::size_t peak_bytes;
+};
+
+inline alloc_stats g_alloc_stats{};
+
+///
+/// Clears the counters and makes the current heap usage the new baseline for the peak
+///
+inline auto reset_alloc_stats() -> void
+{
+    g_alloc_stats.allocations = 0;
+    g_alloc_stats.peak_bytes = g_alloc_stats.bytes_in_use;
+}
+
+///
+/// Resets the peak resident set size of the process (Linux only, silently ignored elsewhere)
+///
+inline auto reset_peak_rss() -> void
+{
+    if (std::FILE* file{ std::fopen("/proc/self/clear_refs", "w") })
+    {
+        std::fputs("5", file);
+        std::fclose(file);
+    }
+}
+
+///
+/// Peak resident set size in KiB since the last reset_peak_rss(), 0 if unknown
+///
+inline auto peak_rss_kib() -> std::size_t
+{
+    std::size_t peak{};
+
+    if (std::FILE* file{ std::fopen("/proc/self/status", "r") })
+    {
+        char line[256];
+
+        while (std::fgets(line, sizeof(line), file))
+            if (std::strncmp(line, "VmHWM:", 6) == 0)
+                peak = std::strtoull(line + 6, nullptr, 10);
+
+        std::fclose(file);
+    }
+
+    return peak;
+}
+
+}   // END BENCH NAMESPACE
+
+auto operator new(std::size_t bytes) -> void*
+{
+    void* block{ std::malloc(bytes ? bytes : 1) };
+
+    if (not block)
+        throw std::bad_alloc{};
+
+    bench::g_alloc_stats.allocations += 1;
+    bench::g_alloc_stats.bytes_in_use += malloc_usable_size(block);
+
+    if (bench::g_alloc_stats.bytes_in_use > bench::g_alloc_stats.peak_bytes)
+        bench::g_alloc_stats.peak_bytes = bench::g_alloc_stats.bytes_in_use;
+
+    return block;
+}
+
+auto operator new[](std::size_t bytes) -> void*
+{
+    return ::operator new(bytes);
+}
+
+auto operator new(std::size_t bytes, const std::nothrow_t&) noexcept -> void*
+{
+    try
+    {
+        return ::operator new(bytes);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+// kept out of line, once inlined gcc flags the free() of a block that came from operator new
+__attribute__((noinline)) auto operator delete(void* block) noexcept -> void
+{
+    if (block)
+        bench::g_alloc_stats.bytes_in_use -= malloc_usable_size(block);
+
+    std::free(block);
+}
+
+auto operator delete[](void* block) noexcept -> void
+{
+    ::operator delete(block);
+}
+
+auto operator delete(void* block, std::size_t) noexcept -> void
+{
+    ::operator delete(block);
+}
+
+auto operator delete[](void* block, std::size_t) noexcept -> void
+{
+    ::operator delete(block);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef BENCH_HH
+#define BENCH_HH
+
+// C++ standard library includes
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+namespace bench
+{
+///
+/// Prevents the compiler from optimizing away "value"
+///
+template <typename T>
+inline auto do_not_optimize(const T& value) -> void
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+///
+/// Runs "body" "iterations" times and returns the average time of one run in nanoseconds
+///
+template <typename Body>
+auto time_ns(std::size_t iterations, Body&& body) -> double
+{
+    const auto start{ std::chrono::steady_clock::now() };
+
+    for (std::size_t iteration{}; iteration < iterations; ++iteration)
+        body();
+
+    const auto elapsed{ std::chrono::steady_clock::now() - start };
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+}   // END BENCH NAMESPACE
+
+#endif
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../bit_vector.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+///
+/// Usage: bit_vector_bench [flags]. Compares a mask of 10^8 flags stored one
+/// byte per flag in kt::vector<bool> with kt::bit_vector: memory, counting
+/// the set flags, and-ing two masks and walking the set flags of a sparse mask
+///
+int main(int argc, char** argv)
+{
+    const std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000 };
+    const std::size_t repetitions{ 5 };
+
+    kt::vector<bool> bytes_lhs{}, bytes_rhs{}, bytes_out{};
+    kt::bit_vector bits_lhs{}, bits_rhs{};
+
+    std::uint64_t state{ 0x9E3779B97F4A7C15ull };
+
+    for (std::size_t index{}; index < count; ++index)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        // lhs dense, rhs sparse with about one flag in 1024
+        bytes_lhs.push_back((state & 1) != 0);
+        bytes_rhs.push_back((state >> 1 & 1023) == 0);
+        bits_lhs.push_back((state & 1) != 0);
+        bits_rhs.push_back((state >> 1 & 1023) == 0);
+    }
+
+    bytes_out.resize(count);
+
+    const double bytes_count_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        std::size_t set{};
+
+        for (const bool flag : bytes_lhs)
+            set += flag;
+
+        bench::do_not_optimize(set);
+    }) / 1e6 };
+
+    const double bits_count_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        bench::do_not_optimize(bits_lhs.count());
+    }) / 1e6 };
+
+    const double bytes_and_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        for (std::size_t index{}; index < count; ++index)
+            bytes_out[index] = bytes_lhs[index] & bytes_rhs[index];
+
+        bench::do_not_optimize(bytes_out[count - 1]);
+    }) / 1e6 };
+
+    const double bits_and_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        kt::bit_vector result{ bits_lhs };
+        result &= bits_rhs;
+
+        bench::do_not_optimize(result.data()[0]);
+    }) / 1e6 };
+
+    const double bytes_walk_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        std::size_t total{};
+
+        for (std::size_t index{}; index < count; ++index)
+            if (bytes_rhs[index])
+                total += index;
+
+        bench::do_not_optimize(total);
+    }) / 1e6 };
+
+    const double bits_walk_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        std::size_t total{};
+
+        for (std::size_t index{ bits_rhs.find_first() }; index != kt::bit_vector::npos; index = bits_rhs.find_next(index))
+            total += index;
+
+        bench::do_not_optimize(total);
+    }) / 1e6 };
+
+    std::printf("%zu flags, ms unless noted\n\n", count);
+    std::printf("%-36s %16s %16s\n", "", "kt::vector<bool>", "kt::bit_vector");
+    std::printf("%-36s %16zu %16zu\n", "bytes", bytes_lhs.capacity(), bits_lhs.capacity() / 8);
+    std::printf("%-36s %16.3f %16.3f\n", "count set flags", bytes_count_ms, bits_count_ms);
+    std::printf("%-36s %16.3f %16.3f\n", "and of two masks (bit_vector copies)", bytes_and_ms, bits_and_ms);
+    std::printf("%-36s %16.3f %16.3f\n", "walk the set flags of a sparse mask", bytes_walk_ms, bits_walk_ms);
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../simd.h"
+#include "../compressed_vector.h"
+
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+
+using id_type = std::uint64_t;
+
+// sorted values with random gaps below "max_gap", like IDs or timestamps
+auto sorted_values(std::size_t count, std::uint64_t max_gap) -> kt::vector<id_type>
+{
+    kt::vector<id_type> values{};
+    values.reserve(count);
+
+    std::mt19937_64 engine{ 42 };
+    id_type value{ 1'700'000'000'000 };
+
+    for (std::size_t index{}; index < count; ++index)
+    {
+        value += 1 + engine() % max_gap;
+        values.push_back(value);
+    }
+
+    return values;
+}
+
+auto run(const char* name, std::size_t count, std::uint64_t max_gap) -> void
+{
+    const kt::vector<id_type> plain{ sorted_values(count, max_gap) };
+    kt::compressed_vector<id_type> packed{};
+
+    const double build_ns{ bench::time_ns(1, [&plain, &packed]() -> void
+    {
+        packed = kt::compressed_vector<id_type>(plain.begin(), plain.end());
+    }) };
+    packed.shrink_to_fit();
+
+    std::vector<std::size_t> indices(1 << 20);
+    std::mt19937 engine{ 42 };
+    std::uniform_int_distribution<std::size_t> distribution{ 0, count - 1 };
+
+    for (auto& index : indices)
+        index = distribution(engine);
+
+    const double plain_scan{ bench::time_ns(5, [&plain]() -> void
+    {
+        id_type total{};
+
+        for (const id_type value : plain)
+            total += value;
+
+        bench::do_not_optimize(total);
+    }) };
+
+    const double packed_scan{ bench::time_ns(5, [&packed]() -> void
+    {
+        id_type total{};
+
+        for (const id_type value : packed)
+            total += value;
+
+        bench::do_not_optimize(total);
+    }) };
+
+    const double plain_random{ bench::time_ns(5, [&plain, &indices]() -> void
+    {
+        id_type total{};
+
+        for (const std::size_t index : indices)
+            total += plain[index];
+
+        bench::do_not_optimize(total);
+    }) };
+
+    const double packed_random{ bench::time_ns(5, [&packed, &indices]() -> void
+    {
+        id_type total{};
+
+        for (const std::size_t index : indices)
+            total += packed[index];
+
+        bench::do_not_optimize(total);
+    }) };
+
+    const double plain_search{ bench::time_ns(5, [&plain, &indices]() -> void
+    {
+        std::size_t total{};
+
+        for (const std::size_t index : indices)
+            total += static_cast<std::size_t>(std::lower_bound(plain.begin(), plain.end(), plain[index] + 1) - plain.begin());
+
+        bench::do_not_optimize(total);
+    }) };
+
+    const double packed_search{ bench::time_ns(5, [&plain, &packed, &indices]() -> void
+    {
+        std::size_t total{};
+
+        for (const std::size_t index : indices)
+            total += packed.lower_bound(plain[index] + 1);
+
+        bench::do_not_optimize(total);
+    }) };
+
+    const double values{ static_cast<double>(count) };
+    const double lookups{ static_cast<double>(indices.size()) };
+
+    std::printf("\n%s, %zu values, gaps below %llu\n", name, count, static_cast<unsigned long long>(max_gap));
+    std::printf("%-22s %16s %16s\n", "", "kt::vector", "compressed");
+    std::printf("%-22s %16.2f %16.2f\n", "bytes per value",
+        static_cast<double>(plain.capacity() * sizeof(id_type)) / values, static_cast<double>(packed.memory_bytes()) / values);
+    std::printf("%-22s %16s %16.2f\n", "build ns/value", "", build_ns / values);
+    std::printf("%-22s %16.2f %16.2f\n", "scan ns/value", plain_scan / values, packed_scan / values);
+    std::printf("%-22s %16.2f %16.2f\n", "scan GB/s decoded", values * sizeof(id_type) / plain_scan,
+        values * sizeof(id_type) / packed_scan);
+    std::printf("%-22s %16.2f %16.2f\n", "random read ns", plain_random / lookups, packed_random / lookups);
+    std::printf("%-22s %16.2f %16.2f\n", "lower_bound ns", plain_search / lookups, packed_search / lookups);
+}
+
+///
+/// Usage: compressed_vector_bench [values]. Compares memory, sequential
+/// scans, random reads and searches over sorted 64 bit IDs and timestamps
+/// in kt::vector and kt::compressed_vector, then the block decode with and
+/// without SSE2
+///
+int main(int argc, char** argv)
+{
+    const std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000 };
+
+    run("dense IDs", count, 16);
+    run("millisecond timestamps", count, 1'000);
+    run("sparse IDs", count, 100'000);
+
+    const kt::vector<id_type> timestamps{ sorted_values(count, 1'000) };
+    const kt::compressed_vector<id_type> packed(timestamps.begin(), timestamps.end());
+    std::vector<id_type> decoded(kt::compressed_vector<id_type>::block_size);
+
+    std::printf("\n%-22s %16s %16s\n", "block decode", "scalar", "best isa");
+
+    double decode_ns[2]{};
+    const kt::simd::isa isas[2]{ kt::simd::isa::scalar, kt::simd::detect_isa() };
+
+    for (int run_index{}; run_index < 2; ++run_index)
+    {
+        kt::simd::force_isa(isas[run_index]);
+
+        decode_ns[run_index] = bench::time_ns(5, [&packed, &decoded]() -> void
+        {
+            for (std::size_t block{}; block < packed.block_count(); ++block)
+                packed.decode_block(block, decoded.data());
+
+            bench::do_not_optimize(decoded[0]);
+        });
+    }
+
+    std::printf("%-22s %16.2f %16.2f\n", "ns/value", decode_ns[0] / static_cast<double>(count),
+        decode_ns[1] / static_cast<double>(count));
+
+    return 0;
+}
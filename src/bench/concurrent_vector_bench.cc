@@ -0,0 +1,86 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../concurrent_vector.h"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+
+// start every thread at the same time and return the wall time of "body" in milliseconds
+template <typename Body>
+auto run_threads(std::size_t threads, Body body) -> double
+{
+    std::vector<std::thread> workers{};
+    std::atomic<bool> start{ false };
+
+    workers.reserve(threads);
+
+    for (std::size_t thread{}; thread < threads; ++thread)
+        workers.emplace_back([&, thread]() -> void
+        {
+            while (not start.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            body(thread);
+        });
+
+    const auto begin{ std::chrono::steady_clock::now() };
+    start.store(true, std::memory_order_release);
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+///
+/// Usage: concurrent_vector_bench [elements]. Every thread count appends the
+/// same total, 4 * 10^6 by default, split evenly between the threads
+///
+int main(int argc, char** argv)
+{
+    std::size_t total{ 4'000'000 };
+
+    if (argc > 1)
+        total = std::strtoull(argv[1], nullptr, 10);
+
+    std::printf("concurrent appends of %zu uint64 elements, million appends per second\n\n", total);
+    std::printf("%8s %22s %22s\n", "threads", "concurrent_vector", "mutex + kt::vector");
+
+    for (std::size_t threads{ 1 }; threads <= 64; threads *= 2)
+    {
+        const std::size_t per_thread{ total / threads };
+
+        kt::concurrent_vector<std::uint64_t> shared{};
+        const double lock_free_ms{ run_threads(threads, [&](std::size_t thread) -> void
+        {
+            for (std::size_t index{}; index < per_thread; ++index)
+                shared.push_back(thread * per_thread + index);
+        }) };
+
+        bench::do_not_optimize(shared[0]);
+
+        kt::vector<std::uint64_t> guarded{};
+        std::mutex lock{};
+        const double mutex_ms{ run_threads(threads, [&](std::size_t thread) -> void
+        {
+            for (std::size_t index{}; index < per_thread; ++index)
+            {
+                const std::lock_guard<std::mutex> guard{ lock };
+                guarded.push_back(thread * per_thread + index);
+            }
+        }) };
+
+        bench::do_not_optimize(guarded[0]);
+
+        const double appends{ static_cast<double>(per_thread * threads) / 1e3 };
+
+        std::printf("%8zu %22.2f %22.2f\n", threads, appends / lock_free_ms, appends / mutex_ms);
+    }
+
+    return 0;
+}
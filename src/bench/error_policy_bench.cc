@@ -0,0 +1,103 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../error_policy.h"
+
+#include <random>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+template <typename Errors>
+using table = kt::vector<std::uint32_t, std::allocator<std::uint32_t>, kt::grow_double, Errors>;
+
+template <typename Errors>
+auto filled(std::size_t count) -> table<Errors>
+{
+    table<Errors> values{};
+    values.reserve(count);
+
+    for (std::size_t index{}; index < count; ++index)
+        values.push_back(static_cast<std::uint32_t>(index * 2654435761u));
+
+    return values;
+}
+
+// random reads through at(), or operator[] when "checked" is false
+template <typename Errors, bool checked>
+auto measure_reads(const table<Errors>& values, const std::vector<std::uint32_t>& indices, std::size_t rounds) -> double
+{
+    const double ns{ bench::time_ns(rounds, [&values, &indices]() -> void
+    {
+        std::uint64_t total{};
+
+        for (const std::uint32_t index : indices)
+        {
+            if constexpr (checked)
+                total += values.at(index);
+            else
+                total += values[index];
+        }
+
+        bench::do_not_optimize(total);
+    }) };
+
+    return ns / static_cast<double>(indices.size());
+}
+
+// reads through try_at(), which reports a bad index with a null pointer under every policy
+template <typename Errors>
+auto measure_try_reads(const table<Errors>& values, const std::vector<std::uint32_t>& indices, std::size_t rounds) -> double
+{
+    const double ns{ bench::time_ns(rounds, [&values, &indices]() -> void
+    {
+        std::uint64_t total{};
+
+        for (const std::uint32_t index : indices)
+            if (const std::uint32_t* value{ values.try_at(index) })
+                total += *value;
+
+        bench::do_not_optimize(total);
+    }) };
+
+    return ns / static_cast<double>(indices.size());
+}
+
+template <typename Errors>
+auto print_row(const char* name, std::size_t count, const std::vector<std::uint32_t>& indices, std::size_t rounds) -> void
+{
+    const table<Errors> values{ filled<Errors>(count) };
+
+    std::printf("%-20s %14.3f %14.3f %14.3f\n", name,
+        measure_reads<Errors, false>(values, indices, rounds),
+        measure_reads<Errors, true>(values, indices, rounds),
+        measure_try_reads<Errors>(values, indices, rounds));
+}
+
+///
+/// Usage: error_policy_bench [elements]. Sums random elements of a table of
+/// 32 bit values through operator[], at() and try_at() under each error
+/// policy, in ns per read
+///
+int main(int argc, char** argv)
+{
+    const std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 16 };
+    const std::size_t rounds{ 200 };
+
+    std::vector<std::uint32_t> indices(1 << 16);
+    std::mt19937 engine{ 42 };
+    std::uniform_int_distribution<std::size_t> distribution{ 0, count - 1 };
+
+    for (auto& index : indices)
+        index = static_cast<std::uint32_t>(distribution(engine));
+
+    std::printf("%zu random reads from %zu elements, ns per read\n\n", indices.size(), count);
+    std::printf("%-20s %14s %14s %14s\n", "policy", "operator[]", "at()", "try_at()");
+
+    print_row<kt::errors_throw>("errors_throw", count, indices, rounds);
+    print_row<kt::errors_abort>("errors_abort", count, indices, rounds);
+    print_row<kt::errors_unchecked>("errors_unchecked", count, indices, rounds);
+
+    return 0;
+}
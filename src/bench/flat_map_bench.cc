@@ -0,0 +1,137 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../flat_map.h"
+
+#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <unordered_map>
+
+///
+/// Usage: flat_map_bench [max entries]. Looks up random keys, half of them
+/// present, in kt::flat_map, std::map and std::unordered_map holding 16 up
+/// to "max entries" 64 bit keys and values, and times bulk loading kt::flat_map
+/// from unsorted keys against inserting them one by one
+///
+int main(int argc, char** argv)
+{
+    const std::size_t max_entries{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1u << 20 };
+    const std::size_t lookups{ 1u << 20 };
+
+    std::uint64_t state{ 0x9E3779B97F4A7C15ull };
+
+    const auto next{ [&state]() -> std::uint64_t
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        return state;
+    } };
+
+    std::printf("random lookups, ns per lookup\n\n");
+    std::printf("%-10s %14s %14s %20s\n", "entries", "kt::flat_map", "std::map", "std::unordered_map");
+
+    for (std::size_t entries{ 16 }; entries <= max_entries; entries *= 4)
+    {
+        kt::vector<std::uint64_t> keys{};
+        kt::vector<std::uint64_t> values{};
+        std::map<std::uint64_t, std::uint64_t> tree{};
+        std::unordered_map<std::uint64_t, std::uint64_t> hash{};
+
+        // only even keys are stored so odd probes miss
+        for (std::size_t index{}; index < entries; ++index)
+        {
+            const std::uint64_t key{ next() & ~1ull };
+
+            keys.push_back(key);
+            values.push_back(index);
+            tree.emplace(key, index);
+            hash.emplace(key, index);
+        }
+
+        kt::vector<std::uint64_t> probes{};
+        probes.reserve(lookups);
+
+        for (std::size_t index{}; index < lookups; ++index)
+            probes.push_back(next() & 1 ? keys[next() % entries] : next() | 1);
+
+        const kt::flat_map<std::uint64_t, std::uint64_t> flat{ std::move(keys), std::move(values) };
+
+        const double flat_ns{ bench::time_ns(1, [&]() -> void
+        {
+            std::uint64_t total{};
+
+            for (const std::uint64_t probe : probes)
+            {
+                const auto found{ flat.find(probe) };
+                total += found != flat.end() ? found.value() : 0;
+            }
+
+            bench::do_not_optimize(total);
+        }) / lookups };
+
+        const double tree_ns{ bench::time_ns(1, [&]() -> void
+        {
+            std::uint64_t total{};
+
+            for (const std::uint64_t probe : probes)
+            {
+                const auto found{ tree.find(probe) };
+                total += found != tree.end() ? found->second : 0;
+            }
+
+            bench::do_not_optimize(total);
+        }) / lookups };
+
+        const double hash_ns{ bench::time_ns(1, [&]() -> void
+        {
+            std::uint64_t total{};
+
+            for (const std::uint64_t probe : probes)
+            {
+                const auto found{ hash.find(probe) };
+                total += found != hash.end() ? found->second : 0;
+            }
+
+            bench::do_not_optimize(total);
+        }) / lookups };
+
+        std::printf("%-10zu %14.1f %14.1f %20.1f\n", entries, flat_ns, tree_ns, hash_ns);
+    }
+
+    // bulk load against one insert per key, the latter is quadratic so keep it small
+    const std::size_t load_entries{ std::min<std::size_t>(max_entries, 1u << 16) };
+
+    kt::vector<std::uint64_t> load_keys{};
+
+    for (std::size_t index{}; index < load_entries; ++index)
+        load_keys.push_back(next());
+
+    const double bulk_ms{ bench::time_ns(1, [&]() -> void
+    {
+        kt::vector<std::uint64_t> keys{ load_keys };
+        kt::vector<std::uint64_t> values{ load_keys };
+
+        kt::flat_map<std::uint64_t, std::uint64_t> flat{ std::move(keys), std::move(values) };
+        bench::do_not_optimize(flat.size());
+    }) / 1e6 };
+
+    const double single_ms{ bench::time_ns(1, [&]() -> void
+    {
+        kt::flat_map<std::uint64_t, std::uint64_t> flat{};
+
+        for (const std::uint64_t key : load_keys)
+            flat.insert(key, key);
+
+        bench::do_not_optimize(flat.size());
+    }) / 1e6 };
+
+    std::printf("\nloading %zu unsorted entries, ms\n\n", load_entries);
+    std::printf("%-24s %10.3f\n", "bulk (sort and merge)", bulk_ms);
+    std::printf("%-24s %10.3f\n", "one insert per entry", single_ms);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../mmap_vector.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+// stand-in for the work of computing one entry of a lookup table
+auto table_entry(std::size_t index) -> std::size_t
+{
+    std::size_t value{ index * 0x9E3779B97F4A7C15ull };
+    value ^= value >> 29;
+
+    return value * 0xBF58476D1CE4E5B9ull;
+}
+
+///
+/// Usage: mmap_vector_bench [elements] [path]. Compares building a lookup
+/// table of 10^7 entries in memory with opening the same table from a file
+///
+int main(int argc, char** argv)
+{
+    const std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000 };
+    const char* const path{ argc > 2 ? argv[2] : "mmap_vector_bench.bin" };
+
+    const double build_ms{ bench::time_ns(1, [count]() -> void
+    {
+        kt::vector<std::size_t> table{};
+
+        for (std::size_t index{}; index < count; ++index)
+            table.push_back(table_entry(index));
+
+        bench::do_not_optimize(table[count - 1]);
+    }) / 1e6 };
+
+    const double write_ms{ bench::time_ns(1, [count, path]() -> void
+    {
+        kt::mmap_vector<std::size_t> table{ path, kt::map_mode::create };
+        table.reserve(count);
+
+        for (std::size_t index{}; index < count; ++index)
+            table.push_back(table_entry(index));
+
+        table.flush();
+    }) / 1e6 };
+
+    double open_ms{};
+    double scan_ms{};
+
+    {
+        const std::size_t repetitions{ 1000 };
+
+        open_ms = bench::time_ns(repetitions, [path]() -> void
+        {
+            const kt::mmap_vector<std::size_t> table{ path, kt::map_mode::read_only };
+            bench::do_not_optimize(table.size());
+        }) / 1e6;
+
+        const kt::mmap_vector<std::size_t> table{ path, kt::map_mode::read_only };
+
+        scan_ms = bench::time_ns(1, [&table]() -> void
+        {
+            std::size_t total{};
+
+            for (const std::size_t value : table)
+                total += value;
+
+            bench::do_not_optimize(total);
+        }) / 1e6;
+    }
+
+    std::remove(path);
+
+    std::printf("lookup table of %zu size_t entries, ms\n\n", count);
+    std::printf("%-36s %12.3f\n", "build kt::vector in memory", build_ms);
+    std::printf("%-36s %12.3f\n", "build mmap_vector and flush", write_ms);
+    std::printf("%-36s %12.6f\n", "open mmap_vector read only", open_ms);
+    std::printf("%-36s %12.3f\n", "first scan of the opened table", scan_ms);
+
+    return 0;
+}
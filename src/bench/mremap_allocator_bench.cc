@@ -0,0 +1,52 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../mremap_allocator.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+// fill a vector with "bytes" worth of elements, then time doubling its capacity
+template <typename Vector>
+auto time_doubling(std::size_t bytes) -> double
+{
+    Vector values{};
+    values.resize_default_init(bytes / sizeof(std::uint64_t));
+
+    for (std::size_t index{}; index < values.size(); ++index)
+        values[index] = index;
+
+    const double ns{ bench::time_ns(1, [&values]() -> void
+    {
+        values.reserve(values.capacity() * 2);
+    }) };
+
+    bench::do_not_optimize(values[values.size() - 1]);
+
+    return ns / 1e6;
+}
+
+///
+/// Usage: mremap_allocator_bench [max MiB]. Times doubling the capacity of a
+/// full kt::vector<uint64_t> of 64 MiB up to 1 GiB by default, copying the
+/// elements with std::allocator against remapping them with mremap_allocator
+///
+int main(int argc, char** argv)
+{
+    const std::size_t max_mebibytes{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024 };
+
+    std::printf("doubling the capacity of a full kt::vector<uint64_t>, ms\n\n");
+    std::printf("%12s %18s %18s\n", "MiB", "std::allocator", "mremap_allocator");
+
+    for (std::size_t mebibytes{ 64 }; mebibytes <= max_mebibytes; mebibytes *= 2)
+    {
+        const std::size_t bytes{ mebibytes * 1024 * 1024 };
+
+        const double copy_ms{ time_doubling<kt::vector<std::uint64_t>>(bytes) };
+        const double remap_ms{ time_doubling<kt::vector<std::uint64_t, kt::mremap_allocator<std::uint64_t>>>(bytes) };
+
+        std::printf("%12zu %18.3f %18.3f\n", mebibytes, copy_ms, remap_ms);
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../parallel.h"
+
+#include <random>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+auto random_values(std::size_t count) -> kt::vector<std::uint32_t>
+{
+    kt::vector<std::uint32_t> values{};
+    values.resize_default_init(count);
+
+    std::mt19937 engine{ 42 };
+
+    for (std::size_t index{}; index < count; ++index)
+        values[index] = static_cast<std::uint32_t>(engine());
+
+    return values;
+}
+
+// milliseconds of one run of "body" on "threads" threads in total, the caller included
+template <typename Body>
+auto run_on(std::size_t threads, Body body) -> double
+{
+    kt::parallel::thread_pool pool{ threads - 1 };
+    return bench::time_ns(3, [&]() -> void { body(pool); }) / 1e6;
+}
+
+///
+/// Usage: parallel_bench [elements]. 10^7 elements by default
+///
+int main(int argc, char** argv)
+{
+    std::size_t count{ 10'000'000 };
+
+    if (argc > 1)
+        count = std::strtoull(argv[1], nullptr, 10);
+
+    const std::size_t hardware{ std::max<std::size_t>(1, std::thread::hardware_concurrency()) };
+    const kt::vector<std::uint32_t> source{ random_values(count) };
+
+    std::printf("kt::parallel over %zu uint32 elements, ms per call (%zu hardware threads)\n\n", count, hardware);
+    std::printf("%8s %12s %12s %12s %12s %12s\n", "threads", "for_each", "transform", "reduce", "scan", "sort");
+
+    for (std::size_t threads{ 1 };; threads = std::min(threads * 2, hardware))
+    {
+        kt::vector<std::uint32_t> values{ source };
+        kt::vector<std::uint64_t> wide{};
+
+        const double for_each{ run_on(threads, [&](kt::parallel::thread_pool& pool) -> void
+        {
+            kt::parallel::for_each(values, [](std::uint32_t& value) -> void { value = value * 2654435761u + 1; },
+                kt::parallel::default_grain<std::uint32_t>(), pool);
+        }) };
+
+        const double transform{ run_on(threads, [&](kt::parallel::thread_pool& pool) -> void
+        {
+            kt::parallel::transform(values, wide, [](std::uint32_t value) -> std::uint64_t { return value * 3ull; },
+                kt::parallel::default_grain<std::uint32_t>(), pool);
+        }) };
+
+        const double reduce{ run_on(threads, [&](kt::parallel::thread_pool& pool) -> void
+        {
+            bench::do_not_optimize(kt::parallel::reduce(wide, std::uint64_t{}, std::plus<>{},
+                kt::parallel::default_grain<std::uint64_t>(), pool));
+        }) };
+
+        const double scan{ run_on(threads, [&](kt::parallel::thread_pool& pool) -> void
+        {
+            kt::parallel::inclusive_scan(wide, std::plus<>{}, kt::parallel::default_grain<std::uint64_t>(), pool);
+        }) };
+
+        const double sort{ run_on(threads, [&](kt::parallel::thread_pool& pool) -> void
+        {
+            kt::vector<std::uint32_t> unsorted{ source };
+            kt::parallel::sort(unsorted, std::less<>{}, kt::parallel::default_grain<std::uint32_t>(), pool);
+            bench::do_not_optimize(unsorted[0]);
+        }) };
+
+        std::printf("%8zu %12.2f %12.2f %12.2f %12.2f %12.2f\n", threads, for_each, transform, reduce, scan, sort);
+
+        if (threads == hardware)
+            break;
+    }
+
+    kt::vector<std::uint32_t> unsorted{ source };
+    const double serial_sort{ bench::time_ns(1, [&]() -> void
+    {
+        std::sort(unsorted.data(), unsorted.data() + unsorted.size());
+    }) / 1e6 };
+
+    std::printf("\nstd::sort on one thread: %.2f ms\n", serial_sort);
+
+    return 0;
+}
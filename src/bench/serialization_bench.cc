@@ -0,0 +1,86 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../serialization.h"
+
+#include <fstream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+
+auto gib_per_second(std::size_t bytes, double ns) -> double
+{
+    return static_cast<double>(bytes) / ns * 1e9 / (1024.0 * 1024.0 * 1024.0);
+}
+
+///
+/// Usage: serialization_bench [MiB] [path]. Writes and reads back a vector
+/// of 256 MiB by default through a file descriptor and through fstreams
+///
+int main(int argc, char** argv)
+{
+    const std::size_t mib{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256 };
+    const char* const path{ argc > 2 ? argv[2] : "serialization_bench.bin" };
+    const std::size_t count{ mib * 1024 * 1024 / sizeof(std::uint64_t) };
+    const std::size_t bytes{ count * sizeof(std::uint64_t) };
+
+    kt::vector<std::uint64_t> values{};
+    values.resize_default_init(count);
+
+    for (std::size_t index{}; index < count; ++index)
+        values[index] = index * 0x9E3779B97F4A7C15ull;
+
+    const double checksum_ns{ bench::time_ns(3, [&values, bytes]() -> void
+    {
+        bench::do_not_optimize(kt::serialization::detail::crc32c(0, values.data(), bytes));
+    }) };
+
+    kt::vector<std::uint64_t> loaded{};
+    kt::io_status status{};
+
+    const double fd_write_ns{ bench::time_ns(1, [&]() -> void
+    {
+        const int fd{ ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+        status = kt::write_to(fd, values);
+        ::close(fd);
+    }) };
+
+    const double fd_read_ns{ bench::time_ns(1, [&]() -> void
+    {
+        const int fd{ ::open(path, O_RDONLY) };
+        status = status == kt::io_status::ok ? kt::read_from(fd, loaded) : status;
+        ::close(fd);
+    }) };
+
+    const double stream_write_ns{ bench::time_ns(1, [&]() -> void
+    {
+        std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+        status = status == kt::io_status::ok ? kt::write_to(out, values) : status;
+    }) };
+
+    const double stream_read_ns{ bench::time_ns(1, [&]() -> void
+    {
+        std::ifstream in{ path, std::ios::binary };
+        status = status == kt::io_status::ok ? kt::read_from(in, loaded) : status;
+    }) };
+
+    std::remove(path);
+
+    if (status != kt::io_status::ok or loaded.size() != count)
+    {
+        std::printf("round trip failed: %s\n", kt::to_string(status));
+        return 1;
+    }
+
+    std::printf("%zu MiB of uint64 through the page cache, GiB/s\n\n", mib);
+    std::printf("%-24s %10.2f\n", "crc32c", gib_per_second(bytes, checksum_ns));
+    std::printf("%-24s %10.2f\n", "write_to(fd)", gib_per_second(bytes, fd_write_ns));
+    std::printf("%-24s %10.2f\n", "read_from(fd)", gib_per_second(bytes, fd_read_ns));
+    std::printf("%-24s %10.2f\n", "write_to(ostream)", gib_per_second(bytes, stream_write_ns));
+    std::printf("%-24s %10.2f\n", "read_from(istream)", gib_per_second(bytes, stream_read_ns));
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "alloc_tracking.h"
+#include "../vector.h"
+#include "../shared_vector.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+struct fan_out_report
+{
+    double copy_ms;
+    double first_write_ms;
+    std::size_t peak_bytes;
+};
+
+// hand "table" to "readers" readers, let each read it once and have the last one change one element
+template <typename Handle, typename Copy, typename Write>
+auto measure_fan_out(const Handle& table, std::size_t readers, Copy&& copy, Write&& write) -> fan_out_report
+{
+    bench::reset_alloc_stats();
+
+    kt::vector<Handle> handed_out{};
+    handed_out.reserve(readers);
+
+    const double copy_ms{ bench::time_ns(1, [&]() -> void
+    {
+        for (std::size_t reader{}; reader < readers; ++reader)
+            handed_out.push_back(copy(table));
+    }) / 1e6 };
+
+    std::uint64_t total{};
+
+    for (std::size_t reader{}; reader < readers; ++reader)
+        total += handed_out[reader][reader];
+
+    bench::do_not_optimize(total);
+
+    const double first_write_ms{ bench::time_ns(1, [&]() -> void
+    {
+        write(handed_out[readers - 1]);
+    }) / 1e6 };
+
+    return { copy_ms, first_write_ms, bench::g_alloc_stats.peak_bytes };
+}
+
+///
+/// Usage: shared_vector_bench [MiB] [readers]. Hands a table of 64 bit
+/// values to every reader as a kt::vector copy and as a kt::shared_vector
+/// snapshot, then writes one element through the last reader's handle
+///
+int main(int argc, char** argv)
+{
+    const std::size_t mebibytes{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64 };
+    const std::size_t readers{ argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16 };
+    const std::size_t count{ mebibytes * 1024 * 1024 / sizeof(std::uint64_t) };
+
+    kt::vector<std::uint64_t> table{};
+    table.reserve(count);
+
+    for (std::size_t index{}; index < count; ++index)
+        table.push_back(index * 0x9E3779B97F4A7C15ull);
+
+    const fan_out_report copies{ measure_fan_out(table, readers,
+        [](const kt::vector<std::uint64_t>& source) -> kt::vector<std::uint64_t> { return source; },
+        [](kt::vector<std::uint64_t>& handle) -> void { handle[0] = 1; }) };
+
+    const kt::shared_vector<std::uint64_t> snapshot{ kt::freeze(std::move(table)) };
+
+    const fan_out_report snapshots{ measure_fan_out(snapshot, readers,
+        [](const kt::shared_vector<std::uint64_t>& source) -> kt::shared_vector<std::uint64_t> { return source; },
+        [](kt::shared_vector<std::uint64_t>& handle) -> void { handle.edit()[0] = 1; }) };
+
+    std::printf("%zu MiB table handed to %zu readers\n\n", mebibytes, readers);
+    std::printf("%-22s %12s %18s %20s\n", "", "copies ms", "first write ms", "peak heap MiB");
+    std::printf("%-22s %12.3f %18.3f %20zu\n", "kt::vector copies", copies.copy_ms, copies.first_write_ms,
+        copies.peak_bytes >> 20);
+    std::printf("%-22s %12.3f %18.3f %20zu\n", "kt::shared_vector", snapshots.copy_ms, snapshots.first_write_ms,
+        snapshots.peak_bytes >> 20);
+
+    return 0;
+}
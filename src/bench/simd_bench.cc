@@ -0,0 +1,122 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../simd.h"
+
+#include <cstdint>
+
+// plain loops over operator[], what callers wrote before simd.h
+template <typename T>
+auto scalar_sum(const kt::vector<T>& values) -> T
+{
+    T total{};
+
+    for (std::size_t index{}; index < values.size(); ++index)
+        total += values[index];
+
+    return total;
+}
+
+template <typename T>
+auto scalar_dot(const kt::vector<T>& lhs, const kt::vector<T>& rhs) -> T
+{
+    T total{};
+
+    for (std::size_t index{}; index < lhs.size(); ++index)
+        total += lhs[index] * rhs[index];
+
+    return total;
+}
+
+template <typename T>
+auto scalar_count(const kt::vector<T>& values, T value) -> std::size_t
+{
+    std::size_t matches{};
+
+    for (std::size_t index{}; index < values.size(); ++index)
+        matches += values[index] == value;
+
+    return matches;
+}
+
+constexpr const char* isa_names[]{ "scalar", "sse2", "avx2", "avx512" };
+
+template <typename T>
+auto run(const char* type_name, std::size_t count) -> void
+{
+    kt::vector<T> lhs{};
+    kt::vector<T> rhs{};
+
+    for (std::size_t index{}; index < count; ++index)
+    {
+        lhs.push_back(static_cast<T>(index % 7));
+        rhs.push_back(static_cast<T>(index % 5));
+    }
+
+    const std::size_t iterations{ 200'000'000 / count + 1 };
+    const double elements{ static_cast<double>(count) };
+
+    const double loop_sum{ bench::time_ns(iterations, [&]() -> void { bench::do_not_optimize(scalar_sum(lhs)); }) / elements };
+    const double loop_dot{ bench::time_ns(iterations, [&]() -> void { bench::do_not_optimize(scalar_dot(lhs, rhs)); }) / elements };
+
+    std::printf("%-8s %10zu %-8s %10.3f %10.3f\n", type_name, count, "loop", loop_sum, loop_dot);
+
+    for (const kt::simd::isa target : { kt::simd::isa::scalar, kt::simd::isa::sse2, kt::simd::isa::avx2, kt::simd::isa::avx512 })
+    {
+        kt::simd::force_isa(target);
+
+        if (kt::simd::active_isa() != target)
+            continue;
+
+        const double sum{ bench::time_ns(iterations, [&]() -> void { bench::do_not_optimize(kt::simd::sum(lhs)); }) / elements };
+        const double dot{ bench::time_ns(iterations, [&]() -> void { bench::do_not_optimize(kt::simd::dot(lhs, rhs)); }) / elements };
+
+        std::printf("%-8s %10zu %-8s %10.3f %10.3f %8.1fx %8.1fx\n", type_name, count, isa_names[static_cast<int>(target)],
+            sum, dot, loop_sum / sum, loop_dot / dot);
+    }
+
+    kt::simd::force_isa(kt::simd::detect_isa());
+}
+
+auto run_count(std::size_t count) -> void
+{
+    kt::vector<std::int32_t> values{};
+
+    for (std::size_t index{}; index < count; ++index)
+        values.push_back(static_cast<std::int32_t>(index % 13));
+
+    const std::size_t iterations{ 200'000'000 / count + 1 };
+    const double elements{ static_cast<double>(count) };
+    const double loop{ bench::time_ns(iterations, [&]() -> void { bench::do_not_optimize(scalar_count(values, 3)); }) / elements };
+
+    std::printf("%-8s %10zu %-8s %10.3f\n", "int32", count, "loop", loop);
+
+    for (const kt::simd::isa target : { kt::simd::isa::scalar, kt::simd::isa::sse2, kt::simd::isa::avx2, kt::simd::isa::avx512 })
+    {
+        kt::simd::force_isa(target);
+
+        if (kt::simd::active_isa() != target)
+            continue;
+
+        const double counted{ bench::time_ns(iterations, [&]() -> void { bench::do_not_optimize(kt::simd::count(values, 3)); }) / elements };
+
+        std::printf("%-8s %10zu %-8s %10.3f %10s %8.1fx\n", "int32", count, isa_names[static_cast<int>(target)],
+            counted, "", loop / counted);
+    }
+
+    kt::simd::force_isa(kt::simd::detect_isa());
+}
+
+int main(int, char**)
+{
+    std::printf("kt::simd kernels vs loops over operator[], ns per element (count for int32)\n\n");
+    std::printf("%-8s %10s %-8s %10s %10s %9s %9s\n", "type", "elements", "kernel", "sum", "dot", "sum x", "dot x");
+
+    for (const std::size_t count : { 1'000, 100'000, 10'000'000 })
+    {
+        run<float>("float", count);
+        run<double>("double", count);
+        run_count(count);
+    }
+
+    return 0;
+}
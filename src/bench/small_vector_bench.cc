@@ -0,0 +1,49 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../small_vector.h"
+
+#include <string>
+
+// fill a fresh container with "count" elements and let it go out of scope
+template <typename Container, typename Make>
+auto fill_and_destroy(std::size_t count, Make make) -> double
+{
+    const std::size_t iterations{ 2'000'000 / (count + 1) + 1000 };
+
+    return bench::time_ns(iterations, [&]() -> void
+    {
+        Container container{};
+
+        for (std::size_t index{}; index < count; ++index)
+            container.push_back(make(index));
+
+        bench::do_not_optimize(container[count - 1]);
+    });
+}
+
+template <typename T, typename Make>
+auto run(const char* type_name, Make make) -> void
+{
+    std::printf("\n%-12s %8s %14s %18s %18s\n", type_name, "elements",
+        "vector ns", "small_vector<8>", "small_vector<32>");
+
+    for (std::size_t count{ 1 }; count <= 64; count *= 2)
+    {
+        const double plain{ fill_and_destroy<kt::vector<T>>(count, make) };
+        const double small8{ fill_and_destroy<kt::small_vector<T, 8>>(count, make) };
+        const double small32{ fill_and_destroy<kt::small_vector<T, 32>>(count, make) };
+
+        std::printf("%-12s %8zu %14.1f %18.1f %18.1f\n", "", count, plain, small8, small32);
+    }
+}
+
+int main(int, char**)
+{
+    std::printf("kt::vector vs kt::small_vector, ns per fill + destroy of one container\n");
+
+    run<int>("int", [](std::size_t index) -> int { return static_cast<int>(index); });
+    run<double>("double", [](std::size_t index) -> double { return 0.5 * static_cast<double>(index); });
+    run<std::string>("std::string", [](std::size_t index) -> std::string { return std::to_string(index); });
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "bench.h"
+#include "../vector.h"
+#include "../soa_vector.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+// the same particle stored as one struct per element
+struct particle
+{
+    float x;
+    float y;
+    float z;
+    float mass;
+    std::uint64_t id;
+    std::uint32_t flags;
+};
+
+///
+/// Usage: soa_vector_bench [elements]. Compares appending particles and
+/// scanning one of their fields between kt::vector<particle> and a
+/// kt::soa_vector holding every field in its own column
+///
+int main(int argc, char** argv)
+{
+    const std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000 };
+    const std::size_t scans{ 20 };
+
+    kt::vector<particle> rows{};
+    kt::soa_vector<float, float, float, float, std::uint64_t, std::uint32_t> columns{};
+
+    const double rows_append_ns{ bench::time_ns(1, [&]() -> void
+    {
+        for (std::size_t index{}; index < count; ++index)
+        {
+            const float value{ static_cast<float>(index & 1023) };
+            rows.push_back(particle{ value, value, value, value, index, 0 });
+        }
+    }) / static_cast<double>(count) };
+
+    const double columns_append_ns{ bench::time_ns(1, [&]() -> void
+    {
+        for (std::size_t index{}; index < count; ++index)
+        {
+            const float value{ static_cast<float>(index & 1023) };
+            columns.emplace_back(value, value, value, value, std::uint64_t{ index }, std::uint32_t{ 0 });
+        }
+    }) / static_cast<double>(count) };
+
+    const double rows_scan_ns{ bench::time_ns(scans, [&]() -> void
+    {
+        float total{};
+
+        for (const particle& row : rows)
+            total += row.mass;
+
+        bench::do_not_optimize(total);
+    }) / static_cast<double>(count) };
+
+    const double columns_scan_ns{ bench::time_ns(scans, [&]() -> void
+    {
+        float total{};
+
+        for (const float mass : columns.column<3>())
+            total += mass;
+
+        bench::do_not_optimize(total);
+    }) / static_cast<double>(count) };
+
+    std::printf("%zu particles of %zu bytes, ns per element\n\n", count, sizeof(particle));
+    std::printf("%-28s %14s %14s\n", "", "kt::vector", "soa_vector");
+    std::printf("%-28s %14.3f %14.3f\n", "append", rows_append_ns, columns_append_ns);
+    std::printf("%-28s %14.3f %14.3f\n", "sum of one float field", rows_scan_ns, columns_scan_ns);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "bench.h"
+#include "alloc_tracking.h"
+#include "../vector.h"
+#include "../stable_vector.h"
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+struct latency_report
+{
+    double percentiles[4];
+    double max_ns;
+    double total_ms;
+    std::size_t peak_bytes;
+};
+
+// time every push_back of "count" elements on its own
+template <typename Container>
+auto measure_push_back(std::size_t count, std::vector<std::uint32_t>& latencies) -> latency_report
+{
+    using clock = std::chrono::steady_clock;
+
+    bench::reset_alloc_stats();
+
+    {
+        Container values{};
+
+        for (std::size_t index{}; index < count; ++index)
+        {
+            const auto start{ clock::now() };
+            values.push_back(index);
+            const auto stop{ clock::now() };
+
+            latencies[index] = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        }
+
+        bench::do_not_optimize(values[count - 1]);
+    }
+
+    const std::size_t peak_bytes{ bench::g_alloc_stats.peak_bytes - bench::g_alloc_stats.bytes_in_use };
+
+    std::sort(latencies.begin(), latencies.end());
+
+    latency_report report{};
+    const double fractions[4]{ 0.5, 0.99, 0.999, 0.9999 };
+
+    for (std::size_t rank{}; rank < 4; ++rank)
+        report.percentiles[rank] = latencies[static_cast<std::size_t>(fractions[rank] * static_cast<double>(count - 1))];
+
+    report.max_ns = latencies[count - 1];
+    report.peak_bytes = peak_bytes;
+
+    for (const std::uint32_t latency : latencies)
+        report.total_ms += latency / 1e6;
+
+    return report;
+}
+
+///
+/// Usage: stable_vector_bench [elements]. Times every single push_back of
+/// 10^7 uint64 elements by default, the percentiles show the latency spikes
+/// kt::vector pays when it reallocates and copies everything
+///
+int main(int argc, char** argv)
+{
+    const std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000 };
+    std::vector<std::uint32_t> latencies(count);
+
+    const latency_report contiguous{ measure_push_back<kt::vector<std::uint64_t>>(count, latencies) };
+    const latency_report segmented{ measure_push_back<kt::stable_vector<std::uint64_t>>(count, latencies) };
+
+    std::printf("push_back latency of %zu uint64 elements, ns\n\n", count);
+    std::printf("%-20s %10s %10s %10s %10s %14s %12s %14s\n", "", "p50", "p99", "p99.9", "p99.99", "max", "total ms", "peak heap B");
+
+    const auto print{ [](const char* name, const latency_report& report) -> void
+    {
+        std::printf("%-20s %10.0f %10.0f %10.0f %10.0f %14.0f %12.3f %14zu\n", name, report.percentiles[0],
+            report.percentiles[1], report.percentiles[2], report.percentiles[3], report.max_ns, report.total_ms,
+            report.peak_bytes);
+    } };
+
+    print("kt::vector", contiguous);
+    print("kt::stable_vector", segmented);
+
+    return 0;
+}
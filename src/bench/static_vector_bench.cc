@@ -0,0 +1,63 @@
+#include "bench.h"
+#include "alloc_tracking.h"
+#include "../vector.h"
+#include "../small_vector.h"
+#include "../static_vector.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+struct batch_report
+{
+    double ns_per_batch;
+    std::size_t allocations;
+};
+
+// build "batches" short lived buffers of 32 values, as a real-time callback would per tick
+template <typename Container>
+auto measure_batches(std::size_t batches) -> batch_report
+{
+    bench::reset_alloc_stats();
+
+    const double total_ns{ bench::time_ns(1, [batches]() -> void
+    {
+        std::uint64_t total{};
+
+        for (std::size_t batch{}; batch < batches; ++batch)
+        {
+            Container values{};
+
+            for (std::uint32_t index{}; index < 32; ++index)
+                values.push_back(static_cast<std::uint32_t>(batch) ^ index);
+
+            total += values[batch & 31];
+        }
+
+        bench::do_not_optimize(total);
+    }) };
+
+    return { total_ns / static_cast<double>(batches), bench::g_alloc_stats.allocations };
+}
+
+///
+/// Usage: static_vector_bench [batches]. Fills a fresh buffer of 32 values
+/// per batch with kt::vector, kt::small_vector<32> and kt::static_vector<32>
+/// and reports the time and heap allocations per batch
+///
+int main(int argc, char** argv)
+{
+    const std::size_t batches{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000 };
+
+    const batch_report heap{ measure_batches<kt::vector<std::uint32_t>>(batches) };
+    const batch_report small{ measure_batches<kt::small_vector<std::uint32_t, 32>>(batches) };
+    const batch_report fixed{ measure_batches<kt::static_vector<std::uint32_t, 32>>(batches) };
+
+    std::printf("%zu batches of 32 push_back\n\n", batches);
+    std::printf("%-28s %14s %18s\n", "", "ns per batch", "allocations");
+    std::printf("%-28s %14.1f %18zu\n", "kt::vector", heap.ns_per_batch, heap.allocations);
+    std::printf("%-28s %14.1f %18zu\n", "kt::small_vector<32>", small.ns_per_batch, small.allocations);
+    std::printf("%-28s %14.1f %18zu\n", "kt::static_vector<32>", fixed.ns_per_batch, fixed.allocations);
+
+    return 0;
+}
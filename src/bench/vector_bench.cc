@@ -0,0 +1,342 @@
+#include "bench.h"
+#include "alloc_tracking.h"
+#include "../vector.h"
+
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// 64 byte trivially copyable payload
+struct blob
+{
+    std::uint64_t words[8];
+};
+
+template <typename T>
+auto make_value(std::size_t index) -> T
+{
+    if constexpr (std::is_same_v<T, std::string>)
+        return std::string(index % 3 == 0 ? 40 : 8, static_cast<char>('a' + index % 26));
+    else if constexpr (std::is_same_v<T, blob>)
+        return blob{ { index, index, index, index, index, index, index, index } };
+    else
+        return static_cast<T>(index);
+}
+
+template <typename T>
+auto weight(const T& value) -> std::size_t
+{
+    if constexpr (std::is_same_v<T, std::string>)
+        return value.size();
+    else if constexpr (std::is_same_v<T, blob>)
+        return static_cast<std::size_t>(value.words[0]);
+    else
+        return static_cast<std::size_t>(value);
+}
+
+template <typename T>
+auto append_to(kt::vector<T>& dest, const kt::vector<T>& source) -> void
+{
+    dest.append(source);
+}
+
+template <typename T>
+auto append_to(std::vector<T>& dest, const std::vector<T>& source) -> void
+{
+    dest.insert(dest.end(), source.begin(), source.end());
+}
+
+template <typename Container>
+auto filled(std::size_t count) -> Container
+{
+    using T = typename Container::value_type;
+    Container container{};
+
+    for (std::size_t index{}; index < count; ++index)
+        container.push_back(make_value<T>(index));
+
+    return container;
+}
+
+struct measurement
+{
+    double ns_per_op;
+    std::size_t allocations;
+    std::size_t peak_bytes;
+    std::size_t peak_rss_kib;
+};
+
+///
+/// Runs "body" enough times to cover about "work" elements and returns the
+/// time per operation, where one run of "body" counts as "ops" operations
+///
+template <typename Body>
+auto measure(std::size_t ops, Body&& body) -> measurement
+{
+    constexpr std::size_t work{ 2'000'000 };
+    const std::size_t repetitions{ ops >= work ? 1 : work / (ops ? ops : 1) };
+
+    // warm up, then count the allocations of a single run
+    body();
+
+    bench::reset_alloc_stats();
+    bench::reset_peak_rss();
+    body();
+    const std::size_t allocations{ bench::g_alloc_stats.allocations };
+    const std::size_t peak_bytes{ bench::g_alloc_stats.peak_bytes - bench::g_alloc_stats.bytes_in_use };
+    const std::size_t peak_rss{ bench::peak_rss_kib() };
+
+    const double ns{ bench::time_ns(repetitions, body) };
+
+    return { ns / static_cast<double>(ops ? ops : 1), allocations, peak_bytes, peak_rss };
+}
+
+template <typename Container>
+auto bench_push_back(std::size_t count) -> measurement
+{
+    using T = typename Container::value_type;
+
+    return measure(count, [count]() -> void
+    {
+        Container container{};
+
+        for (std::size_t index{}; index < count; ++index)
+            container.push_back(make_value<T>(index));
+
+        bench::do_not_optimize(container[count - 1]);
+    });
+}
+
+template <typename Container>
+auto bench_emplace_back(std::size_t count) -> measurement
+{
+    using T = typename Container::value_type;
+
+    return measure(count, [count]() -> void
+    {
+        Container container{};
+
+        for (std::size_t index{}; index < count; ++index)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+                container.emplace_back(index % 3 == 0 ? 40 : 8, 'e');
+            else
+                container.emplace_back(make_value<T>(index));
+        }
+
+        bench::do_not_optimize(container[count - 1]);
+    });
+}
+
+template <typename Container>
+auto bench_copy(std::size_t count) -> measurement
+{
+    const Container source{ filled<Container>(count) };
+
+    return measure(count, [&source]() -> void
+    {
+        Container copy{ source };
+        bench::do_not_optimize(copy[0]);
+    });
+}
+
+template <typename Container>
+auto bench_move(std::size_t count) -> measurement
+{
+    Container source{ filled<Container>(count) };
+
+    return measure(1, [&source]() -> void
+    {
+        Container moved{ std::move(source) };
+        source = std::move(moved);
+        bench::do_not_optimize(source[0]);
+    });
+}
+
+template <typename Container>
+auto bench_append(std::size_t count) -> measurement
+{
+    const Container half{ filled<Container>(count / 2 + 1) };
+
+    return measure(count, [&half]() -> void
+    {
+        Container container{ half };
+        append_to(container, half);
+        bench::do_not_optimize(container[0]);
+    });
+}
+
+template <typename Container>
+auto bench_iterate(std::size_t count) -> measurement
+{
+    const Container source{ filled<Container>(count) };
+
+    return measure(count, [&source]() -> void
+    {
+        std::size_t total{};
+
+        for (const auto& value : source)
+            total += weight(value);
+
+        bench::do_not_optimize(total);
+    });
+}
+
+template <typename Container>
+auto bench_random_access(std::size_t count) -> measurement
+{
+    const Container source{ filled<Container>(count) };
+
+    std::vector<std::uint32_t> indices(count < 4096 ? count : 4096);
+    std::mt19937 engine{ 42 };
+    std::uniform_int_distribution<std::size_t> distribution{ 0, count - 1 };
+
+    for (auto& index : indices)
+        index = static_cast<std::uint32_t>(distribution(engine));
+
+    return measure(indices.size(), [&source, &indices]() -> void
+    {
+        std::size_t total{};
+
+        for (const auto index : indices)
+            total += weight(source[index]);
+
+        bench::do_not_optimize(total);
+    });
+}
+
+// sorting a copy of shuffled elements, the copy is part of the time for both containers
+template <typename Container>
+auto bench_sort(std::size_t count) -> measurement
+{
+    using T = typename Container::value_type;
+
+    Container shuffled{ filled<Container>(count) };
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{ 42 });
+
+    return measure(count, [&shuffled]() -> void
+    {
+        Container container{ shuffled };
+
+        std::sort(container.begin(), container.end(), [](const T& lhs, const T& rhs) -> bool
+        {
+            return weight(lhs) < weight(rhs);
+        });
+
+        bench::do_not_optimize(container[0]);
+    });
+}
+
+template <typename Container>
+auto bench_lower_bound(std::size_t count) -> measurement
+{
+    using T = typename Container::value_type;
+
+    // weights of the filled elements grow with the index for int and blob
+    const Container source{ filled<Container>(count) };
+
+    std::vector<std::size_t> probes(4096);
+    std::mt19937 engine{ 42 };
+    std::uniform_int_distribution<std::size_t> distribution{ 0, count - 1 };
+
+    for (auto& probe : probes)
+        probe = distribution(engine);
+
+    return measure(probes.size(), [&source, &probes]() -> void
+    {
+        std::size_t total{};
+
+        for (const std::size_t probe : probes)
+            total += static_cast<std::size_t>(std::lower_bound(source.begin(), source.end(), probe,
+                [](const T& value, std::size_t key) -> bool { return weight(value) < key; }) - source.begin());
+
+        bench::do_not_optimize(total);
+    });
+}
+
+template <typename Container>
+auto bench_clear(std::size_t count) -> measurement
+{
+    Container container{};
+    double total_ns{};
+    std::size_t repetitions{ count >= 1'000'000 ? 2 : 1'000'000 / count };
+
+    bench::reset_alloc_stats();
+
+    for (std::size_t repetition{}; repetition < repetitions; ++repetition)
+    {
+        container = filled<Container>(count);
+
+        const auto start{ std::chrono::steady_clock::now() };
+        container.clear();
+        const auto elapsed{ std::chrono::steady_clock::now() - start };
+
+        total_ns += std::chrono::duration<double, std::nano>(elapsed).count();
+    }
+
+    return { total_ns / static_cast<double>(repetitions * count), 0, 0, 0 };
+}
+
+auto print_row(const char* name, const char* type_name, std::size_t count,
+    const measurement& kt_result, const measurement& std_result) -> void
+{
+    std::printf("%-14s %-12s %10zu %12.2f %12.2f %7.2f %8zu %8zu %14zu %14zu %12zu %12zu\n",
+        name, type_name, count, kt_result.ns_per_op, std_result.ns_per_op,
+        kt_result.ns_per_op / std_result.ns_per_op, kt_result.allocations, std_result.allocations,
+        kt_result.peak_bytes, std_result.peak_bytes, kt_result.peak_rss_kib, std_result.peak_rss_kib);
+}
+
+template <typename T>
+auto run_type(const char* type_name, std::size_t max_count) -> void
+{
+    using kt_vector = kt::vector<T>;
+    using std_vector = std::vector<T>;
+
+    for (std::size_t count{ 1 }; count <= max_count; count *= 10)
+    {
+        print_row("push_back", type_name, count, bench_push_back<kt_vector>(count), bench_push_back<std_vector>(count));
+        print_row("emplace_back", type_name, count, bench_emplace_back<kt_vector>(count), bench_emplace_back<std_vector>(count));
+        print_row("copy", type_name, count, bench_copy<kt_vector>(count), bench_copy<std_vector>(count));
+        print_row("move", type_name, count, bench_move<kt_vector>(count), bench_move<std_vector>(count));
+        print_row("append", type_name, count, bench_append<kt_vector>(count), bench_append<std_vector>(count));
+        print_row("iterate", type_name, count, bench_iterate<kt_vector>(count), bench_iterate<std_vector>(count));
+        print_row("random_access", type_name, count, bench_random_access<kt_vector>(count), bench_random_access<std_vector>(count));
+        print_row("sort", type_name, count, bench_sort<kt_vector>(count), bench_sort<std_vector>(count));
+
+        if constexpr (not std::is_same_v<T, std::string>)
+            print_row("lower_bound", type_name, count, bench_lower_bound<kt_vector>(count), bench_lower_bound<std_vector>(count));
+
+        print_row("clear", type_name, count, bench_clear<kt_vector>(count), bench_clear<std_vector>(count));
+    }
+}
+
+///
+/// Usage: vector_bench [max elements]. Trivial types go up to the given
+/// size (10^7 by default, up to 10^8), non-trivial ones to a tenth of it
+///
+int main(int argc, char** argv)
+{
+    std::size_t max_count{ 10'000'000 };
+
+    if (argc > 1)
+        max_count = std::strtoull(argv[1], nullptr, 10);
+
+    bench::reset_peak_rss();
+
+    std::printf("kt::vector vs std::vector, ns per element (move: per move pair), allocations, peak heap bytes and peak RSS of one run\n\n");
+    std::printf("%-14s %-12s %10s %12s %12s %7s %8s %8s %14s %14s %12s %12s\n", "benchmark", "type", "elements",
+        "kt ns/op", "std ns/op", "kt/std", "kt allc", "std allc", "kt peak B", "std peak B", "kt RSS KiB", "std RSS KiB");
+
+    run_type<int>("int", max_count);
+    run_type<blob>("blob64", max_count / 10);
+    run_type<std::string>("std::string", max_count / 10);
+
+    std::printf("\npeak RSS: %zu KiB\n", bench::peak_rss_kib());
+
+    return 0;
+}
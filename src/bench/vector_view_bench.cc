@@ -0,0 +1,76 @@
+#include "bench.h"
+#include "alloc_tracking.h"
+#include "../vector.h"
+#include "../vector_view.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+// what a worker does with its slice
+static auto checksum(kt::vector_view<const std::uint32_t> slice) -> std::uint64_t
+{
+    std::uint64_t total{};
+
+    for (const std::uint32_t value : slice)
+        total = total * 31 + value;
+
+    return total;
+}
+
+///
+/// Usage: vector_view_bench [elements] [slice size]. Hands consecutive
+/// slices of a vector to a worker function, once as kt::vector copies made
+/// with the subrange constructor and once as kt::vector_view chunks
+///
+int main(int argc, char** argv)
+{
+    const std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50'000'000 };
+    const std::size_t slice_size{ argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024 };
+    const std::size_t repetitions{ 3 };
+
+    kt::vector<std::uint32_t> values{};
+    values.reserve(count);
+
+    for (std::size_t index{}; index < count; ++index)
+        values.push_back(static_cast<std::uint32_t>(index * 2654435761u));
+
+    bench::reset_alloc_stats();
+
+    const double copy_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        std::uint64_t total{};
+
+        for (std::size_t offset{}; offset < count; offset += slice_size)
+        {
+            const std::size_t length{ offset + slice_size < count ? slice_size : count - offset };
+            const kt::vector<std::uint32_t> slice(values.begin() + offset, length);
+
+            total += checksum(slice);
+        }
+
+        bench::do_not_optimize(total);
+    }) / 1e6 };
+
+    const std::size_t copy_allocations{ bench::g_alloc_stats.allocations / repetitions };
+    bench::reset_alloc_stats();
+
+    const double view_ms{ bench::time_ns(repetitions, [&]() -> void
+    {
+        std::uint64_t total{};
+
+        for (const kt::vector_view<const std::uint32_t> slice : kt::vector_view{ values }.chunks(slice_size))
+            total += checksum(slice);
+
+        bench::do_not_optimize(total);
+    }) / 1e6 };
+
+    const std::size_t view_allocations{ bench::g_alloc_stats.allocations / repetitions };
+
+    std::printf("%zu elements in slices of %zu\n\n", count, slice_size);
+    std::printf("%-28s %12s %14s\n", "", "ms per pass", "allocations");
+    std::printf("%-28s %12.3f %14zu\n", "kt::vector subrange copies", copy_ms, copy_allocations);
+    std::printf("%-28s %12.3f %14zu\n", "kt::vector_view chunks", view_ms, view_allocations);
+
+    return 0;
+}
@@ -0,0 +1,528 @@
+#ifndef BIT_VECTOR_HH
+#define BIT_VECTOR_HH
+
+// C++ standard library includes
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <initializer_list>
+
+#include "vector.h"
+#include "simd.h"
+
+namespace kt
+{
+///
+/// Vector of bools packed 64 to a word, a separate container rather than a
+/// kt::vector<bool> specialization so kt::vector<bool> keeps handing out
+/// real bool references. Single bits are accessed through a proxy
+/// reference, ranges are set, reset and flipped a word at a time, and
+/// counting and the bitwise operators between vectors run on the kernels of
+/// simd.h. The bits past size() in the last word are always zero
+///
+class bit_vector
+{
+public:
+    using word_type             = std::uint64_t;
+    using value_type            = bool;
+    using size_type             = std::size_t;
+    using const_reference_type  = bool;
+
+    static constexpr size_type bits_per_word{ 64 };
+
+    ///
+    /// Returned by the find functions when there is no set bit
+    ///
+    static constexpr size_type npos{ static_cast<size_type>(-1) };
+
+    ///
+    /// Proxy for one bit: converts to bool and assigning to it writes the bit
+    ///
+    class reference_type
+    {
+    public:
+        reference_type(word_type* word, word_type mask) : m_word{ word }, m_mask{ mask } { }
+
+        reference_type(const reference_type&) = default;
+
+        auto operator=(bool value) -> reference_type&
+        {
+            if (value)
+                *this->m_word |= this->m_mask;
+            else
+                *this->m_word &= ~this->m_mask;
+
+            return *this;
+        }
+
+        // assigns the bit, not the proxy
+        auto operator=(const reference_type& other) -> reference_type&
+        {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const { return (*this->m_word & this->m_mask) != 0; }
+
+        auto flip() -> reference_type&
+        {
+            *this->m_word ^= this->m_mask;
+            return *this;
+        }
+
+    private:
+        word_type* m_word;
+        word_type m_mask;
+    };
+
+    ///
+    /// Random access iterator over the bits, dereferencing yields a
+    /// reference_type, or a bool for the constant iterator
+    ///
+    template <bool Const>
+    class basic_iterator
+    {
+        using word_pointer = std::conditional_t<Const, const word_type*, word_type*>;
+
+    public:
+        using iterator_category     = std::random_access_iterator_tag;
+        using value_type            = bool;
+        using difference_type       = std::ptrdiff_t;
+        using reference             = std::conditional_t<Const, bool, reference_type>;
+        using pointer               = void;
+
+        basic_iterator() = default;
+        basic_iterator(word_pointer words, size_type index) : m_words{ words }, m_index{ index } { }
+
+        // a mutable iterator converts to a constant one
+        template <bool OtherConst, typename = std::enable_if_t<Const and not OtherConst>>
+        basic_iterator(const basic_iterator<OtherConst>& other) : m_words{ other.m_words }, m_index{ other.m_index } { }
+
+        auto operator*() const -> reference
+        {
+            if constexpr (Const)
+                return (this->m_words[this->m_index / bits_per_word] >> (this->m_index % bits_per_word)) & 1;
+            else
+                return { this->m_words + this->m_index / bits_per_word, word_type{ 1 } << (this->m_index % bits_per_word) };
+        }
+
+        auto operator[](difference_type offset) const -> reference { return *(*this + offset); }
+
+        auto index() const -> size_type { return this->m_index; }
+
+        auto operator++() -> basic_iterator& { ++this->m_index; return *this; }
+        auto operator--() -> basic_iterator& { --this->m_index; return *this; }
+        auto operator++(int) -> basic_iterator { basic_iterator copy{ *this }; ++this->m_index; return copy; }
+        auto operator--(int) -> basic_iterator { basic_iterator copy{ *this }; --this->m_index; return copy; }
+
+        auto operator+=(difference_type offset) -> basic_iterator& { this->m_index += offset; return *this; }
+        auto operator-=(difference_type offset) -> basic_iterator& { this->m_index -= offset; return *this; }
+
+        auto operator+(difference_type offset) const -> basic_iterator { return { this->m_words, this->m_index + offset }; }
+        auto operator-(difference_type offset) const -> basic_iterator { return { this->m_words, this->m_index - offset }; }
+
+        auto operator-(const basic_iterator& other) const -> difference_type
+        {
+            return static_cast<difference_type>(this->m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        auto operator==(const basic_iterator& other) const -> bool { return this->m_index == other.m_index; }
+        auto operator!=(const basic_iterator& other) const -> bool { return this->m_index != other.m_index; }
+        auto operator<(const basic_iterator& other) const -> bool { return this->m_index < other.m_index; }
+        auto operator>(const basic_iterator& other) const -> bool { return this->m_index > other.m_index; }
+        auto operator<=(const basic_iterator& other) const -> bool { return this->m_index <= other.m_index; }
+        auto operator>=(const basic_iterator& other) const -> bool { return this->m_index >= other.m_index; }
+
+        friend auto operator+(difference_type offset, const basic_iterator& it) -> basic_iterator { return it + offset; }
+
+    private:
+        template <bool>
+        friend class basic_iterator;
+
+        word_pointer m_words{};
+        size_type m_index{};
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    ///
+    /// Default constructor
+    ///
+    bit_vector() = default;
+
+    ///
+    /// Construct a vector of "count" bits all set to "value"
+    ///
+    explicit bit_vector(size_type count, bool value = false)
+    {
+        resize(count, value);
+    }
+
+    bit_vector(std::initializer_list<bool> content)
+    {
+        reserve(content.size());
+
+        for (const bool value : content)
+            push_back(value);
+    }
+
+    ///
+    /// Returns the amount of bits in the vector
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_size;
+    }
+
+    ///
+    /// Returns the amount of bits the words have room for
+    ///
+    auto capacity() const -> size_type
+    {
+        return this->m_words.capacity() * bits_per_word;
+    }
+
+    auto empty() const -> bool
+    {
+        return this->m_size == 0;
+    }
+
+    ///
+    /// Returns the words holding the bits, bit i is bit i % 64 of word i / 64
+    ///
+    auto data() -> word_type*
+    {
+        return this->m_words.data();
+    }
+
+    auto data() const -> const word_type*
+    {
+        return this->m_words.data();
+    }
+
+    auto word_count() const -> size_type
+    {
+        return this->m_words.size();
+    }
+
+    auto operator[](size_type index) -> reference_type
+    {
+        return { this->m_words.data() + index / bits_per_word, bit_mask(index) };
+    }
+
+    auto operator[](size_type index) const -> const_reference_type
+    {
+        return test(index);
+    }
+
+    auto test(size_type index) const -> bool
+    {
+        return (this->m_words[index / bits_per_word] & bit_mask(index)) != 0;
+    }
+
+    ///
+    /// Make room for at least "count" bits
+    ///
+    auto reserve(size_type count) -> void
+    {
+        this->m_words.reserve(words_for(count));
+    }
+
+    ///
+    /// Adjust the vector to contain "count" bits, new bits are set to "value"
+    ///
+    auto resize(size_type count, bool value = false) -> void
+    {
+        const size_type old_size{ this->m_size };
+
+        if (count > old_size)
+        {
+            this->m_words.resize(words_for(count));
+
+            if (this->m_words.size() != words_for(count))
+                return;
+
+            this->m_size = count;
+
+            if (value)
+                set(old_size, count);
+        }
+        else
+        {
+            this->m_words.remove_n(this->m_words.size() - words_for(count));
+            this->m_size = count;
+            clear_unused_bits();
+        }
+    }
+
+    auto shrink_to_fit() -> void
+    {
+        this->m_words.shrink_to_fit();
+    }
+
+    ///
+    /// Insert one bit at the end of the vector
+    ///
+    auto push_back(bool value) -> void
+    {
+        if (this->m_size % bits_per_word == 0)
+        {
+            const size_type words{ this->m_words.size() };
+            this->m_words.push_back(0);
+
+            if (this->m_words.size() == words)
+                return;
+        }
+
+        if (value)
+            this->m_words[this->m_size / bits_per_word] |= bit_mask(this->m_size);
+
+        this->m_size += 1;
+    }
+
+    ///
+    /// Remove the last bit from the vector
+    ///
+    auto pop_back() -> void
+    {
+        if (this->m_size != 0)
+            resize(this->m_size - 1);
+    }
+
+    auto clear() -> void
+    {
+        this->m_words.clear();
+        this->m_size = 0;
+    }
+
+    auto set(size_type index) -> void { this->m_words[index / bits_per_word] |= bit_mask(index); }
+    auto reset(size_type index) -> void { this->m_words[index / bits_per_word] &= ~bit_mask(index); }
+    auto flip(size_type index) -> void { this->m_words[index / bits_per_word] ^= bit_mask(index); }
+
+    ///
+    /// Set, reset or flip the bits in [first, last) a word at a time
+    ///
+    auto set(size_type first, size_type last) -> void
+    {
+        for_each_word(first, last, [](word_type& word, word_type mask) -> void { word |= mask; });
+    }
+
+    auto reset(size_type first, size_type last) -> void
+    {
+        for_each_word(first, last, [](word_type& word, word_type mask) -> void { word &= ~mask; });
+    }
+
+    auto flip(size_type first, size_type last) -> void
+    {
+        for_each_word(first, last, [](word_type& word, word_type mask) -> void { word ^= mask; });
+    }
+
+    ///
+    /// Set, reset or flip every bit
+    ///
+    auto set() -> void { set(0, this->m_size); }
+    auto reset() -> void { reset(0, this->m_size); }
+    auto flip() -> void { flip(0, this->m_size); }
+
+    ///
+    /// Amount of set bits
+    ///
+    auto count() const -> size_type
+    {
+        return simd::popcount(this->m_words.data(), this->m_words.size());
+    }
+
+    auto any() const -> bool { return find_first() != npos; }
+    auto none() const -> bool { return find_first() == npos; }
+    auto all() const -> bool { return count() == this->m_size; }
+
+    ///
+    /// Index of the first set bit, npos if there is none
+    ///
+    auto find_first() const -> size_type
+    {
+        return find_from(0);
+    }
+
+    ///
+    /// Index of the first set bit after "index", npos if there is none
+    ///
+    auto find_next(size_type index) const -> size_type
+    {
+        return index + 1 >= this->m_size ? npos : find_from(index + 1);
+    }
+
+    ///
+    /// Bitwise operations with a vector of the same size. Vectors of
+    /// different sizes fail an assert in debug builds, otherwise they are
+    /// rejected and this vector is left as it is
+    ///
+    auto operator&=(const bit_vector& other) -> bit_vector&
+    {
+        if (same_size(other))
+            simd::bit_and(this->m_words.data(), other.m_words.data(), this->m_words.data(), this->m_words.size());
+
+        return *this;
+    }
+
+    auto operator|=(const bit_vector& other) -> bit_vector&
+    {
+        if (same_size(other))
+            simd::bit_or(this->m_words.data(), other.m_words.data(), this->m_words.data(), this->m_words.size());
+
+        return *this;
+    }
+
+    auto operator^=(const bit_vector& other) -> bit_vector&
+    {
+        if (same_size(other))
+            simd::bit_xor(this->m_words.data(), other.m_words.data(), this->m_words.data(), this->m_words.size());
+
+        return *this;
+    }
+
+    auto operator~() const -> bit_vector
+    {
+        bit_vector result{ *this };
+        result.flip();
+
+        return result;
+    }
+
+    auto operator==(const bit_vector& other) const -> bool
+    {
+        if (this->m_size != other.m_size)
+            return false;
+
+        for (size_type word{}; word < this->m_words.size(); ++word)
+            if (this->m_words[word] != other.m_words[word])
+                return false;
+
+        return true;
+    }
+
+    auto operator!=(const bit_vector& other) const -> bool
+    {
+        return not (*this == other);
+    }
+
+    auto begin() -> iterator { return { this->m_words.data(), 0 }; }
+    auto end() -> iterator { return { this->m_words.data(), this->m_size }; }
+    auto begin() const -> const_iterator { return { this->m_words.data(), 0 }; }
+    auto end() const -> const_iterator { return { this->m_words.data(), this->m_size }; }
+    auto cbegin() const -> const_iterator { return begin(); }
+    auto cend() const -> const_iterator { return end(); }
+
+private:
+    static constexpr auto words_for(size_type bits) -> size_type
+    {
+        return (bits + bits_per_word - 1) / bits_per_word;
+    }
+
+    static constexpr auto bit_mask(size_type index) -> word_type
+    {
+        return word_type{ 1 } << (index % bits_per_word);
+    }
+
+    // bits [first, last) of one word, 0 <= first < last <= 64
+    static constexpr auto range_mask(size_type first, size_type last) -> word_type
+    {
+        const word_type upto_last{ last == bits_per_word ? ~word_type{} : (word_type{ 1 } << last) - 1 };
+        return upto_last & ~((word_type{ 1 } << first) - 1);
+    }
+
+    ///
+    /// Call "operation" with every word overlapping [first, last) and the mask
+    /// of the bits of that word inside the range
+    ///
+    template <typename Operation>
+    auto for_each_word(size_type first, size_type last, Operation operation) -> void
+    {
+        if (last > this->m_size)
+            last = this->m_size;
+
+        if (first >= last)
+            return;
+
+        const size_type first_word{ first / bits_per_word };
+        const size_type last_word{ (last - 1) / bits_per_word };
+
+        if (first_word == last_word)
+        {
+            operation(this->m_words[first_word], range_mask(first % bits_per_word, (last - 1) % bits_per_word + 1));
+            return;
+        }
+
+        operation(this->m_words[first_word], range_mask(first % bits_per_word, bits_per_word));
+
+        for (size_type word{ first_word + 1 }; word < last_word; ++word)
+            operation(this->m_words[word], ~word_type{});
+
+        operation(this->m_words[last_word], range_mask(0, (last - 1) % bits_per_word + 1));
+    }
+
+    auto find_from(size_type index) const -> size_type
+    {
+        if (index >= this->m_size)
+            return npos;
+
+        size_type word{ index / bits_per_word };
+        word_type bits{ this->m_words[word] & ~(bit_mask(index) - 1) };
+
+        while (bits == 0)
+        {
+            if (++word == this->m_words.size())
+                return npos;
+
+            bits = this->m_words[word];
+        }
+
+        return word * bits_per_word + static_cast<size_type>(__builtin_ctzll(bits));
+    }
+
+    // keeps the bits past size() at zero so count and comparisons can look at whole words
+    auto clear_unused_bits() -> void
+    {
+        if (const size_type used{ this->m_size % bits_per_word }; used != 0)
+            this->m_words[this->m_words.size() - 1] &= range_mask(0, used);
+    }
+
+    auto same_size(const bit_vector& other) const -> bool
+    {
+        assert(this->m_size == other.m_size and "bitwise operation between bit vectors of different sizes");
+        return this->m_size == other.m_size;
+    }
+
+    vector<word_type> m_words{};
+    size_type m_size{};
+};
+
+inline auto operator&(const bit_vector& lhs, const bit_vector& rhs) -> bit_vector
+{
+    bit_vector result{ lhs };
+    result &= rhs;
+
+    return result;
+}
+
+inline auto operator|(const bit_vector& lhs, const bit_vector& rhs) -> bit_vector
+{
+    bit_vector result{ lhs };
+    result |= rhs;
+
+    return result;
+}
+
+inline auto operator^(const bit_vector& lhs, const bit_vector& rhs) -> bit_vector
+{
+    bit_vector result{ lhs };
+    result ^= rhs;
+
+    return result;
+}
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,588 @@
+#ifndef COMPRESSED_VECTOR_HH
+#define COMPRESSED_VECTOR_HH
+
+// C++ standard library includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+#include "vector.h"
+#include "simd.h"
+
+namespace kt
+{
+namespace detail
+{
+    // values per block, and 32 bit lanes the packed words of a block are interleaved over
+    inline constexpr std::size_t packed_block_size{ 128 };
+    inline constexpr std::size_t packed_lanes{ 4 };
+
+    // bits per offset of the blocks stored without packing, for 64 bit spans
+    inline constexpr std::uint32_t wide_block_bits{ 64 };
+
+    template <typename UInt>
+    using unpack_function = void (*)(const std::uint32_t*, UInt, UInt*);
+
+    inline constexpr auto low_bits_mask(std::uint32_t bits) -> std::uint32_t
+    {
+        return bits >= 32 ? ~std::uint32_t{} : (std::uint32_t{ 1 } << bits) - 1;
+    }
+
+    inline auto bits_needed(std::uint64_t span) -> std::uint32_t
+    {
+        return span ? 64 - static_cast<std::uint32_t>(__builtin_clzll(span)) : 0;
+    }
+
+    ///
+    /// Words taken by a block whose offsets need "bits" bits
+    ///
+    inline constexpr auto packed_words(std::uint32_t bits) -> std::size_t
+    {
+        return bits > 32 ? packed_block_size * 2 : bits * packed_lanes;
+    }
+
+    ///
+    /// Store the offsets of a full block from "base" in "bits" <= 32 bits each.
+    /// Offset 4k + l goes to lane l at bit k * bits, the lanes are interleaved
+    /// one 32 bit word at a time so one 128 bit load brings the same word of
+    /// every lane. "words" must be zeroed
+    ///
+    template <typename UInt>
+    auto pack_block(const UInt* values, UInt base, std::uint32_t bits, std::uint32_t* words) -> void
+    {
+        for (std::size_t row{}; row < packed_block_size / packed_lanes; ++row)
+        {
+            const std::size_t position{ row * bits };
+            const std::size_t shift{ position % 32 };
+            std::uint32_t* const word{ words + position / 32 * packed_lanes };
+
+            for (std::size_t lane{}; lane < packed_lanes; ++lane)
+            {
+                const std::uint32_t offset{ static_cast<std::uint32_t>(values[row * packed_lanes + lane] - base) };
+
+                word[lane] |= offset << shift;
+
+                if (shift + bits > 32)
+                    word[lane + packed_lanes] |= offset >> (32 - shift);
+            }
+        }
+    }
+
+    ///
+    /// Offset of the value in "slot" of a block stored in "words"
+    ///
+    inline auto unpack_one(const std::uint32_t* words, std::uint32_t bits, std::size_t slot) -> std::uint64_t
+    {
+        if (bits == 0)
+            return 0;
+
+        if (bits > 32)
+        {
+            std::uint64_t offset;
+            std::memcpy(&offset, words + slot * 2, sizeof(offset));
+
+            return offset;
+        }
+
+        const std::size_t position{ slot / packed_lanes * bits };
+        const std::size_t shift{ position % 32 };
+        const std::uint32_t* const word{ words + position / 32 * packed_lanes + slot % packed_lanes };
+
+        std::uint64_t offset{ word[0] >> shift };
+
+        if (shift + bits > 32)
+            offset |= std::uint64_t{ word[packed_lanes] } << (32 - shift);
+
+        return offset & low_bits_mask(bits);
+    }
+
+    // portable version, one lane at a time
+    namespace scalar
+    {
+        template <std::uint32_t Bits, typename UInt>
+        auto unpack_block(const std::uint32_t* words, UInt base, UInt* out) -> void
+        {
+            if constexpr (Bits == 0)
+                std::fill_n(out, packed_block_size, base);
+            else
+            {
+                for (std::size_t row{}; row < packed_block_size / packed_lanes; ++row)
+                {
+                    const std::size_t position{ row * Bits };
+                    const std::size_t shift{ position % 32 };
+                    const std::uint32_t* const word{ words + position / 32 * packed_lanes };
+
+                    for (std::size_t lane{}; lane < packed_lanes; ++lane)
+                    {
+                        std::uint32_t offset{ word[lane] >> shift };
+
+                        if (shift + Bits > 32)
+                            offset |= word[lane + packed_lanes] << (32 - shift);
+
+                        out[row * packed_lanes + lane] = base + static_cast<UInt>(offset & low_bits_mask(Bits));
+                    }
+                }
+            }
+        }
+    }   // END KT::DETAIL::SCALAR NAMESPACE
+
+#if defined(KT_SIMD_X86)
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+    // the four lanes of a block in one register, a row of four values per step
+    namespace sse2
+    {
+        template <std::uint32_t Bits, typename UInt>
+        auto unpack_block(const std::uint32_t* words, UInt base, UInt* out) -> void
+        {
+            if constexpr (Bits == 0)
+                std::fill_n(out, packed_block_size, base);
+            else
+            {
+                const __m128i mask{ _mm_set1_epi32(static_cast<int>(low_bits_mask(Bits))) };
+
+                for (std::size_t row{}; row < packed_block_size / packed_lanes; ++row)
+                {
+                    const std::size_t position{ row * Bits };
+                    const std::size_t shift{ position % 32 };
+                    const std::uint32_t* const word{ words + position / 32 * packed_lanes };
+
+                    __m128i offsets{ _mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(word)),
+                        _mm_cvtsi32_si128(static_cast<int>(shift))) };
+
+                    if (shift + Bits > 32)
+                    {
+                        const __m128i high{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(word + packed_lanes)) };
+                        offsets = _mm_or_si128(offsets, _mm_sll_epi32(high, _mm_cvtsi32_si128(static_cast<int>(32 - shift))));
+                    }
+
+                    offsets = _mm_and_si128(offsets, mask);
+
+                    if constexpr (sizeof(UInt) == 4)
+                    {
+                        const __m128i values{ _mm_add_epi32(offsets, _mm_set1_epi32(static_cast<int>(base))) };
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + row * packed_lanes), values);
+                    }
+                    else
+                    {
+                        // widen the four offsets to 64 bits before adding the base
+                        const __m128i zero{ _mm_setzero_si128() };
+                        const __m128i wide_base{ _mm_set1_epi64x(static_cast<long long>(base)) };
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + row * packed_lanes),
+                            _mm_add_epi64(_mm_unpacklo_epi32(offsets, zero), wide_base));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + row * packed_lanes + 2),
+                            _mm_add_epi64(_mm_unpackhi_epi32(offsets, zero), wide_base));
+                    }
+                }
+            }
+        }
+    }   // END KT::DETAIL::SSE2 NAMESPACE
+#pragma GCC pop_options
+
+#endif
+
+    // one unpack function per bit width, so the shifts of every row are known at compile time
+    template <typename UInt, std::size_t... Bits>
+    constexpr auto scalar_unpackers(std::index_sequence<Bits...>) -> std::array<unpack_function<UInt>, sizeof...(Bits)>
+    {
+        return { &scalar::unpack_block<Bits, UInt>... };
+    }
+
+#if defined(KT_SIMD_X86)
+    template <typename UInt, std::size_t... Bits>
+    constexpr auto sse2_unpackers(std::index_sequence<Bits...>) -> std::array<unpack_function<UInt>, sizeof...(Bits)>
+    {
+        return { &sse2::unpack_block<Bits, UInt>... };
+    }
+#endif
+
+    ///
+    /// Write the 128 values of a block stored in "words" to "out"
+    ///
+    template <typename UInt>
+    auto unpack_block(const std::uint32_t* words, std::uint32_t bits, UInt base, UInt* out) -> void
+    {
+        if constexpr (sizeof(UInt) == 8)
+        {
+            if (bits > 32)
+            {
+                std::memcpy(out, words, packed_block_size * sizeof(UInt));
+
+                for (std::size_t slot{}; slot < packed_block_size; ++slot)
+                    out[slot] += base;
+
+                return;
+            }
+        }
+
+#if defined(KT_SIMD_X86)
+        static constexpr auto sse2_table{ sse2_unpackers<UInt>(std::make_index_sequence<33>{}) };
+
+        if (simd::active_isa() != simd::isa::scalar)
+        {
+            sse2_table[bits](words, base, out);
+            return;
+        }
+#endif
+        static constexpr auto scalar_table{ scalar_unpackers<UInt>(std::make_index_sequence<33>{}) };
+
+        scalar_table[bits](words, base, out);
+    }
+}   // END KT::DETAIL NAMESPACE
+
+///
+/// Append only sequence of unsigned integers stored in blocks of 128 with
+/// frame of reference coding: every block keeps its smallest value and the
+/// offsets of the others from it, bit packed with as many bits as the
+/// largest offset needs. Sorted IDs or timestamps whose blocks span a few
+/// thousand take 10 to 16 bits per value instead of 64.
+///
+/// Reading one value finds its block by division and extracts its bits
+/// without decoding anything else. The iterators and decode_block() unpack
+/// whole blocks at once, with SSE2 when available. The last, partially
+/// filled block is kept uncompressed until it fills up.
+///
+/// Values can not be changed once added. Iterators are invalidated by
+/// push_back and each one carries a decoded block, so they are cheap to
+/// advance but not to copy
+///
+template <typename UInt>
+class compressed_vector
+{
+    static_assert(std::is_unsigned_v<UInt> and (sizeof(UInt) == 4 or sizeof(UInt) == 8),
+        "compressed_vector holds 32 or 64 bit unsigned integers");
+
+    struct block_header
+    {
+        UInt base;                  // smallest value of the block
+        std::uint32_t bits;         // bits per offset, wide_block_bits when not packed
+        std::size_t first_word;     // position of the block in m_words
+    };
+
+public:
+    using value_type            = UInt;
+    using size_type             = std::size_t;
+
+    static constexpr size_type block_size{ detail::packed_block_size };
+
+    ///
+    /// Forward iterator decoding one block at a time
+    ///
+    class const_iterator
+    {
+    public:
+        using iterator_category     = std::forward_iterator_tag;
+        using value_type            = UInt;
+        using difference_type       = std::ptrdiff_t;
+        using reference             = const UInt&;
+        using pointer               = const UInt*;
+
+        const_iterator() = default;
+
+        const_iterator(const compressed_vector* owner, size_type index)
+            :   m_owner{ owner }, m_index{ index }
+        {
+            if (this->m_index < this->m_owner->size())
+                this->m_owner->decode_block(this->m_index / block_size, this->m_decoded);
+        }
+
+        auto operator*() const -> reference
+        {
+            return this->m_decoded[this->m_index % block_size];
+        }
+
+        auto operator->() const -> pointer
+        {
+            return this->m_decoded + this->m_index % block_size;
+        }
+
+        auto operator++() -> const_iterator&
+        {
+            if (++this->m_index % block_size == 0 and this->m_index < this->m_owner->size())
+                this->m_owner->decode_block(this->m_index / block_size, this->m_decoded);
+
+            return *this;
+        }
+
+        auto operator++(int) -> const_iterator
+        {
+            const_iterator copy{ *this };
+            ++*this;
+            return copy;
+        }
+
+        auto operator==(const const_iterator& other) const -> bool
+        {
+            return this->m_index == other.m_index;
+        }
+
+        auto operator!=(const const_iterator& other) const -> bool
+        {
+            return not (*this == other);
+        }
+
+    private:
+        const compressed_vector* m_owner{};
+        size_type m_index{};
+        UInt m_decoded[block_size]{};
+    };
+
+    using iterator = const_iterator;
+
+    ///
+    /// Default constructor. The vector is empty
+    ///
+    compressed_vector() = default;
+
+    compressed_vector(std::initializer_list<UInt> values)
+    {
+        append(values.begin(), values.end());
+    }
+
+    template <typename InputIt>
+    compressed_vector(InputIt first, InputIt last)
+    {
+        append(first, last);
+    }
+
+    ///
+    /// Amount of values stored
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_blocks.size() * block_size + this->m_tail.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+    ///
+    /// Amount of blocks, counting the partially filled last one
+    ///
+    auto block_count() const -> size_type
+    {
+        return this->m_blocks.size() + (this->m_tail.empty() ? 0 : 1);
+    }
+
+    ///
+    /// Bytes held by the compressed values, the block headers and the
+    /// uncompressed last block
+    ///
+    auto memory_bytes() const -> size_type
+    {
+        return this->m_words.capacity() * sizeof(std::uint32_t) + this->m_blocks.capacity() * sizeof(block_header)
+            + this->m_tail.capacity() * sizeof(UInt);
+    }
+
+    ///
+    /// Value at position "index", extracted without decoding its block
+    ///
+    auto operator[](size_type index) const -> UInt
+    {
+        const size_type block{ index / block_size };
+
+        if (block == this->m_blocks.size())
+            return this->m_tail[index % block_size];
+
+        const block_header& header{ this->m_blocks[block] };
+
+        return header.base + static_cast<UInt>(detail::unpack_one(this->m_words.data() + header.first_word,
+            header.bits, index % block_size));
+    }
+
+    auto front() const -> UInt
+    {
+        return (*this)[0];
+    }
+
+    auto back() const -> UInt
+    {
+        return (*this)[size() - 1];
+    }
+
+    ///
+    /// Add "value" at the end. Every 128 values the last block is compressed
+    ///
+    auto push_back(UInt value) -> void
+    {
+        if (this->m_tail.capacity() == 0)
+            this->m_tail.reserve(block_size);
+
+        this->m_tail.push_back(value);
+
+        if (this->m_tail.size() == block_size)
+            seal_tail();
+    }
+
+    template <typename InputIt>
+    auto append(InputIt first, InputIt last) -> void
+    {
+        for (; first != last; ++first)
+            push_back(static_cast<UInt>(*first));
+    }
+
+    ///
+    /// Write the values of block "block" to "out", which must have room for
+    /// block_size values. Returns the amount written, less than block_size
+    /// only for the last block
+    ///
+    auto decode_block(size_type block, UInt* out) const -> size_type
+    {
+        if (block == this->m_blocks.size())
+        {
+            std::copy(this->m_tail.begin(), this->m_tail.end(), out);
+            return this->m_tail.size();
+        }
+
+        const block_header& header{ this->m_blocks[block] };
+        detail::unpack_block(this->m_words.data() + header.first_word, header.bits, header.base, out);
+
+        return block_size;
+    }
+
+    ///
+    /// Every value, decompressed into a kt::vector
+    ///
+    auto to_vector() const -> vector<UInt>
+    {
+        vector<UInt> values{};
+        values.resize_default_init(size());
+
+        for (size_type block{}; block < block_count(); ++block)
+            decode_block(block, values.data() + block * block_size);
+
+        return values;
+    }
+
+    ///
+    /// Position of the first value not less than "value", size() if there is
+    /// none. The values must be sorted. Only the smallest value of each block
+    /// is searched, then the values of a single block are extracted one by one
+    ///
+    auto lower_bound(UInt value) const -> size_type
+    {
+        const size_type after{ static_cast<size_type>(std::partition_point(this->m_blocks.begin(), this->m_blocks.end(),
+            [value](const block_header& header) -> bool { return header.base < value; }) - this->m_blocks.begin()) };
+
+        if (after > 0)
+        {
+            // binary search of the packed block, extracting only the probed values
+            const block_header& header{ this->m_blocks[after - 1] };
+            const std::uint32_t* const words{ this->m_words.data() + header.first_word };
+            const std::uint64_t offset{ static_cast<std::uint64_t>(value - header.base) };
+
+            size_type first{};
+            size_type count{ block_size };
+
+            while (count > 0)
+            {
+                const size_type half{ count / 2 };
+
+                if (detail::unpack_one(words, header.bits, first + half) < offset)
+                {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                    count = half;
+            }
+
+            if (first != block_size)
+                return (after - 1) * block_size + first;
+        }
+
+        if (after < this->m_blocks.size())
+            return after * block_size;
+
+        return this->m_blocks.size() * block_size
+            + static_cast<size_type>(std::lower_bound(this->m_tail.begin(), this->m_tail.end(), value) - this->m_tail.begin());
+    }
+
+    auto clear() -> void
+    {
+        this->m_words.clear();
+        this->m_blocks.clear();
+        this->m_tail.clear();
+    }
+
+    ///
+    /// Give back the memory reserved past the compressed blocks
+    ///
+    auto shrink_to_fit() -> void
+    {
+        this->m_words.shrink_to_fit();
+        this->m_blocks.shrink_to_fit();
+    }
+
+    auto begin() const -> const_iterator
+    {
+        return { this, 0 };
+    }
+
+    auto end() const -> const_iterator
+    {
+        return { this, size() };
+    }
+
+    auto cbegin() const -> const_iterator
+    {
+        return begin();
+    }
+
+    auto cend() const -> const_iterator
+    {
+        return end();
+    }
+
+private:
+    ///
+    /// Compress the full last block and start a new one
+    ///
+    auto seal_tail() -> void
+    {
+        const auto [smallest, largest]{ std::minmax_element(this->m_tail.begin(), this->m_tail.end()) };
+        const UInt base{ *smallest };
+        std::uint32_t bits{ detail::bits_needed(*largest - base) };
+
+        std::uint32_t packed[detail::packed_words(detail::wide_block_bits)]{};
+
+        if (bits > 32)
+        {
+            bits = detail::wide_block_bits;
+
+            for (size_type slot{}; slot < block_size; ++slot)
+            {
+                const std::uint64_t offset{ this->m_tail[slot] - base };
+                std::memcpy(packed + slot * 2, &offset, sizeof(offset));
+            }
+        }
+        else
+            detail::pack_block(this->m_tail.data(), base, bits, packed);
+
+        this->m_blocks.push_back({ base, bits, this->m_words.size() });
+        this->m_words.append(packed, packed + detail::packed_words(bits));
+        this->m_tail.clear();
+    }
+
+    vector<std::uint32_t> m_words{};
+    vector<block_header> m_blocks{};
+    vector<UInt> m_tail{};
+
+    // CONSTRAINTS:
+    // m_tail holds less than block_size values, the ones after the last block
+    // m_blocks[i] describes values [i * block_size, (i + 1) * block_size)
+};
+
+}   // END KT NAMESPACE
+
+#endif
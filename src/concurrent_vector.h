@@ -0,0 +1,344 @@
+#ifndef CONCURRENT_VECTOR_HH
+#define CONCURRENT_VECTOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+#include "error_policy.h"
+#include "growth_policy.h"
+#include "segment_math.h"
+
+namespace kt
+{
+///
+/// Vector that many threads can append to at once. Elements live in
+/// segments that are never moved or freed while the vector is alive:
+/// segment 0 holds first_segment_size elements and every following segment
+/// twice as many as the one before, so an index is turned into a segment
+/// and an offset with a single count-leading-zeros.
+///
+/// push_back and emplace_back reserve an index with one atomic increment,
+/// construct the element in place and then publish it through a per-slot
+/// flag. Any thread may read an element once it is published: either
+/// because it got the index back from push_back, because is_published()
+/// returned true, or because the index is below published_size() and no
+/// emplace_back failed.
+///
+/// An emplace_back whose constructor throws leaves a dead slot behind: its
+/// index stays counted by size() and published_size() steps over it, but
+/// is_published() never returns true for it. A failed segment allocation
+/// gives its index back when no other thread reserved one after it,
+/// otherwise the slot stays unsettled and published_size() stops there
+/// until clear()
+///
+/// clear(), reserve() racing with clear() and destruction are not safe
+/// while other threads use the vector
+///
+template <typename T, typename Alloc = std::allocator<T>, typename Errors = errors_throw>
+class concurrent_vector
+{
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using byte_alloc = typename alloc_traits::template rebind_alloc<unsigned char>;
+    using byte_traits = std::allocator_traits<byte_alloc>;
+    using ready_flag = std::atomic<unsigned char>;
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+        "concurrent_vector does not support over-aligned element types");
+
+public:
+    using value_type            = T;
+    using allocator_type        = Alloc;
+    using error_policy          = Errors;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    ///
+    /// Returned by push_back and emplace_back if no segment could be allocated
+    ///
+    static constexpr size_type npos{ static_cast<size_type>(-1) };
+
+    ///
+    /// Elements in segment 0, the smallest power of two covering a cache line worth of them
+    ///
+    static constexpr size_type first_segment_size{ detail::segment_math<T>::first_segment_size };
+
+    concurrent_vector() = default;
+
+    explicit concurrent_vector(const Alloc& alloc)
+        :   m_alloc{ alloc }
+    {
+
+    }
+
+    concurrent_vector(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+    ~concurrent_vector()
+    {
+        clear();
+        release_segments();
+    }
+
+    ///
+    /// Number of indices handed out so far. Some of them may still be under
+    /// construction, use published_size() or is_published() before reading
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_reserved.load(std::memory_order_acquire);
+    }
+
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+    ///
+    /// Length of the prefix of slots that are all published or dead
+    ///
+    auto published_size() const -> size_type
+    {
+        size_type published{ this->m_published.load(std::memory_order_acquire) };
+        const size_type reserved{ this->m_reserved.load(std::memory_order_acquire) };
+        const size_type start{ published };
+
+        while (published < reserved and is_settled(published))
+            ++published;
+
+        // other readers may have advanced it meanwhile, never move it backwards
+        size_type current{ start };
+
+        while (current < published and not this->m_published.compare_exchange_weak(current, published,
+            std::memory_order_release, std::memory_order_acquire))
+        {
+
+        }
+
+        return published > current ? published : current;
+    }
+
+    ///
+    /// True once the element at "index" is constructed and visible to the calling thread
+    ///
+    auto is_published(size_type index) const -> bool
+    {
+        const auto [segment, offset]{ segments::locate(index) };
+        unsigned char* const block{ this->m_segments[segment].load(std::memory_order_acquire) };
+
+        return block and ready_flags(block, segment)[offset].load(std::memory_order_acquire) == slot_published;
+    }
+
+    ///
+    /// Element at "index", which has to be published
+    ///
+    auto operator[](size_type index) -> reference_type
+    {
+        const auto [segment, offset]{ segments::locate(index) };
+        return elements(this->m_segments[segment].load(std::memory_order_acquire))[offset];
+    }
+
+    auto operator[](size_type index) const -> const_reference_type
+    {
+        const auto [segment, offset]{ segments::locate(index) };
+        return elements(this->m_segments[segment].load(std::memory_order_acquire))[offset];
+    }
+
+    ///
+    /// Pointer to the element at "index", nullptr if it is not published (yet)
+    ///
+    auto try_get(size_type index) const -> const T*
+    {
+        return index < size() and is_published(index) ? &(*this)[index] : nullptr;
+    }
+
+    ///
+    /// Allocate the segments needed to hold "count" elements so
+    /// appending up to that many elements never allocates
+    ///
+    auto reserve(size_type count) -> void
+    {
+        if (count == 0)
+            return;
+
+        const size_type last_segment{ segments::locate(count - 1).first };
+
+        for (size_type segment{}; segment <= last_segment; ++segment)
+            if (not segment_for(segment))
+                return;
+    }
+
+    ///
+    /// Construct an element in place and return its index. If the segment it
+    /// belongs to could not be allocated the error policy is told and, if it
+    /// returns, npos is returned. If the constructor throws the slot is marked
+    /// dead before the exception leaves. The reference from
+    /// operator[] stays valid until the vector is cleared or destroyed
+    ///
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> size_type
+    {
+        const size_type index{ this->m_reserved.fetch_add(1, std::memory_order_relaxed) };
+        const auto [segment, offset]{ segments::locate(index) };
+
+        unsigned char* const block{ segment_for(segment) };
+
+        if (not block)
+        {
+            // give the index back unless another thread already reserved past it
+            size_type expected{ index + 1 };
+            this->m_reserved.compare_exchange_strong(expected, index, std::memory_order_relaxed);
+
+            Errors::on_allocation_failure("could not allocate block of memory...");
+            return npos;
+        }
+
+        try
+        {
+            alloc_traits::construct(this->m_alloc, elements(block) + offset, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            ready_flags(block, segment)[offset].store(slot_dead, std::memory_order_release);
+            throw;
+        }
+
+        ready_flags(block, segment)[offset].store(slot_published, std::memory_order_release);
+
+        return index;
+    }
+
+    auto push_back(const_reference_type value) -> size_type
+    {
+        return emplace_back(value);
+    }
+
+    auto push_back(T&& value) -> size_type
+    {
+        return emplace_back(std::move(value));
+    }
+
+    ///
+    /// Destroy every published element. The segments are kept for reuse
+    ///
+    auto clear() -> void
+    {
+        const size_type reserved{ this->m_reserved.load(std::memory_order_acquire) };
+
+        for (size_type index{}; index < reserved; ++index)
+        {
+            const auto [segment, offset]{ segments::locate(index) };
+            unsigned char* const block{ this->m_segments[segment].load(std::memory_order_acquire) };
+
+            if (block and ready_flags(block, segment)[offset].exchange(slot_empty, std::memory_order_acq_rel) == slot_published)
+                alloc_traits::destroy(this->m_alloc, elements(block) + offset);
+        }
+
+        this->m_reserved.store(0, std::memory_order_release);
+        this->m_published.store(0, std::memory_order_release);
+    }
+
+    auto get_allocator() const -> allocator_type
+    {
+        return this->m_alloc;
+    }
+
+private:
+    using segments = detail::segment_math<T>;
+
+    static constexpr size_type segment_count{ segments::max_segments };
+
+    // states of a ready flag
+    static constexpr unsigned char slot_empty{ 0 };
+    static constexpr unsigned char slot_published{ 1 };
+    static constexpr unsigned char slot_dead{ 2 };
+
+    // a segment is one block: the elements followed by one ready flag per element
+    static constexpr auto segment_bytes(size_type segment) -> size_type
+    {
+        return segments::segment_size(segment) * (sizeof(T) + sizeof(ready_flag));
+    }
+
+    static auto elements(unsigned char* block) -> T*
+    {
+        return reinterpret_cast<T*>(block);
+    }
+
+    static auto ready_flags(unsigned char* block, size_type segment) -> ready_flag*
+    {
+        return reinterpret_cast<ready_flag*>(block + segments::segment_size(segment) * sizeof(T));
+    }
+
+    ///
+    /// Block of "segment", allocating it if no thread did so yet. When two
+    /// threads race to allocate the same segment the loser frees its block
+    ///
+    auto segment_for(size_type segment) -> unsigned char*
+    {
+        unsigned char* block{ this->m_segments[segment].load(std::memory_order_acquire) };
+
+        if (block)
+            return block;
+
+        byte_alloc bytes{ this->m_alloc };
+        unsigned char* fresh{};
+
+        try
+        {
+            fresh = byte_traits::allocate(bytes, segment_bytes(segment));
+        }
+        catch (const std::bad_alloc&)
+        {
+            return nullptr;
+        }
+
+        ready_flag* const flags{ ready_flags(fresh, segment) };
+
+        for (size_type offset{}; offset < segments::segment_size(segment); ++offset)
+            ::new (static_cast<void*>(flags + offset)) ready_flag{ slot_empty };
+
+        if (this->m_segments[segment].compare_exchange_strong(block, fresh,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+            return fresh;
+
+        byte_traits::deallocate(bytes, fresh, segment_bytes(segment));
+
+        return block;
+    }
+
+    // published or left dead by a throwing constructor, either way no longer pending
+    auto is_settled(size_type index) const -> bool
+    {
+        const auto [segment, offset]{ segments::locate(index) };
+        unsigned char* const block{ this->m_segments[segment].load(std::memory_order_acquire) };
+
+        return block and ready_flags(block, segment)[offset].load(std::memory_order_acquire) != slot_empty;
+    }
+
+    auto release_segments() -> void
+    {
+        byte_alloc bytes{ this->m_alloc };
+
+        for (size_type segment{}; segment < segment_count; ++segment)
+            if (unsigned char* block{ this->m_segments[segment].exchange(nullptr) })
+                byte_traits::deallocate(bytes, block, segment_bytes(segment));
+    }
+
+    Alloc m_alloc{};
+    std::atomic<unsigned char*> m_segments[segment_count]{};
+
+    // on their own cache lines, every append touches m_reserved
+    alignas(64) std::atomic<size_type> m_reserved{};
+    alignas(64) mutable std::atomic<size_type> m_published{};
+};
+
+}   // END KT NAMESPACE
+
+#endif
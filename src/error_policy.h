@@ -0,0 +1,115 @@
+#ifndef ERROR_POLICY_HH
+#define ERROR_POLICY_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <string_view>
+
+namespace kt
+{
+class out_of_bounds : public std::exception
+{
+public:
+    out_of_bounds() = default;
+    ~out_of_bounds() = default;
+
+    const char* what() const noexcept override
+    {
+        return this->m_exc.data();
+    }
+
+private:
+    std::string_view m_exc{ "[out_of_bounds]: Index out of bounds\n" };
+};
+
+class empty_vector : public std::exception
+{
+public:
+    empty_vector() = default;
+    ~empty_vector() = default;
+
+    const char* what() const noexcept override
+    {
+        return this->m_exc.data();
+    }
+
+private:
+    std::string_view m_exc{ "[empty_vector]: vector has no elements\n" };
+};
+
+///
+/// Error policies decide what kt::vector does when at() gets an index past
+/// the end or a block of memory can not be obtained. Every policy provides
+///
+///     static auto on_out_of_bounds(std::size_t index, std::size_t count) -> void
+///     static auto on_allocation_failure(const char* message) -> void
+///
+/// If they return, at() reads the element anyway and the operation that
+/// needed memory leaves the vector as it was. The try_* members of
+/// kt::vector report failures through their return value under every policy
+///
+
+///
+/// Throws kt::empty_vector or kt::out_of_bounds from at() and std::bad_alloc
+/// when out of memory, like the standard containers. The default
+///
+struct errors_throw
+{
+    [[noreturn]] static auto on_out_of_bounds(std::size_t, std::size_t count) -> void
+    {
+        if (count == 0)
+            throw empty_vector{};
+
+        throw out_of_bounds{};
+    }
+
+    [[noreturn]] static auto on_allocation_failure(const char*) -> void
+    {
+        throw std::bad_alloc{};
+    }
+};
+
+///
+/// Writes a message to stderr and aborts, for code built without exceptions
+/// or where either failure is a bug
+///
+struct errors_abort
+{
+    [[noreturn]] static auto on_out_of_bounds(std::size_t index, std::size_t count) noexcept -> void
+    {
+        std::fprintf(stderr, "[out_of_bounds]: index %zu in a vector of %zu elements, aborting\n", index, count);
+        std::abort();
+    }
+
+    [[noreturn]] static auto on_allocation_failure(const char* message) noexcept -> void
+    {
+        std::fprintf(stderr, "%s, aborting\n", message);
+        std::abort();
+    }
+};
+
+///
+/// No checks at all: at() is operator[] and failed allocations leave the
+/// vector unchanged without a word. Nothing is left on the hot path;
+/// use the try_* members where a failure has to be noticed
+///
+struct errors_unchecked
+{
+    static constexpr auto on_out_of_bounds(std::size_t, std::size_t) noexcept -> void
+    {
+
+    }
+
+    static constexpr auto on_allocation_failure(const char*) noexcept -> void
+    {
+
+    }
+};
+
+}   // END KT NAMESPACE
+
+#endif
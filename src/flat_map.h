@@ -0,0 +1,398 @@
+#ifndef FLAT_MAP_HH
+#define FLAT_MAP_HH
+
+// C++ standard library includes
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <initializer_list>
+
+#include "vector.h"
+#include "flat_set.h"
+
+namespace kt
+{
+///
+/// Map kept sorted by key with the keys and the values in two separate
+/// kt::vectors. A lookup only touches the keys, so the binary search packs
+/// as many of them per cache line as possible, and values are only read
+/// for the entry that was found. Like flat_set, single inserts shift the
+/// entries after them and bulk loads should use the constructor or the
+/// batched insert.
+///
+/// Dereferencing an iterator yields a std::pair<const Key&, T&> proxy,
+/// the iterators also offer key() and value()
+///
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class flat_map
+{
+public:
+    using key_type              = Key;
+    using mapped_type           = T;
+    using key_compare           = Compare;
+    using size_type             = std::size_t;
+
+    template <bool Const>
+    class basic_iterator
+    {
+        using owner_type = std::conditional_t<Const, const flat_map, flat_map>;
+        using mapped_reference = std::conditional_t<Const, const T&, T&>;
+
+    public:
+        using iterator_category     = std::random_access_iterator_tag;
+        using value_type            = std::pair<Key, T>;
+        using difference_type       = std::ptrdiff_t;
+        using reference             = std::pair<const Key&, mapped_reference>;
+        using pointer               = void;
+
+        basic_iterator() = default;
+        basic_iterator(owner_type* owner, size_type index) : m_owner{ owner }, m_index{ index } { }
+
+        // a mutable iterator converts to a constant one
+        template <bool OtherConst, typename = std::enable_if_t<Const and not OtherConst>>
+        basic_iterator(const basic_iterator<OtherConst>& other) : m_owner{ other.m_owner }, m_index{ other.m_index } { }
+
+        auto operator*() const -> reference { return { key(), value() }; }
+        auto operator[](difference_type offset) const -> reference { return *(*this + offset); }
+
+        auto key() const -> const Key& { return this->m_owner->m_keys[this->m_index]; }
+        auto value() const -> mapped_reference { return this->m_owner->m_values[this->m_index]; }
+        auto index() const -> size_type { return this->m_index; }
+
+        auto operator++() -> basic_iterator& { ++this->m_index; return *this; }
+        auto operator--() -> basic_iterator& { --this->m_index; return *this; }
+        auto operator++(int) -> basic_iterator { basic_iterator copy{ *this }; ++this->m_index; return copy; }
+        auto operator--(int) -> basic_iterator { basic_iterator copy{ *this }; --this->m_index; return copy; }
+
+        auto operator+=(difference_type offset) -> basic_iterator& { this->m_index += offset; return *this; }
+        auto operator-=(difference_type offset) -> basic_iterator& { this->m_index -= offset; return *this; }
+
+        auto operator+(difference_type offset) const -> basic_iterator { return { this->m_owner, this->m_index + offset }; }
+        auto operator-(difference_type offset) const -> basic_iterator { return { this->m_owner, this->m_index - offset }; }
+
+        auto operator-(const basic_iterator& other) const -> difference_type
+        {
+            return static_cast<difference_type>(this->m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        auto operator==(const basic_iterator& other) const -> bool { return this->m_index == other.m_index; }
+        auto operator!=(const basic_iterator& other) const -> bool { return this->m_index != other.m_index; }
+        auto operator<(const basic_iterator& other) const -> bool { return this->m_index < other.m_index; }
+        auto operator>(const basic_iterator& other) const -> bool { return this->m_index > other.m_index; }
+        auto operator<=(const basic_iterator& other) const -> bool { return this->m_index <= other.m_index; }
+        auto operator>=(const basic_iterator& other) const -> bool { return this->m_index >= other.m_index; }
+
+        friend auto operator+(difference_type offset, const basic_iterator& it) -> basic_iterator { return it + offset; }
+
+    private:
+        template <bool>
+        friend class basic_iterator;
+
+        owner_type* m_owner{};
+        size_type m_index{};
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    flat_map() = default;
+
+    explicit flat_map(const Compare& comp)
+        :   m_comp{ comp }
+    {
+
+    }
+
+    ///
+    /// Take "keys" and the matching "values" in any order. They are sorted
+    /// once; of repeated keys the first one and its value are kept. The map
+    /// stays empty if the two vectors differ in size
+    ///
+    flat_map(vector<Key>&& keys, vector<T>&& values, const Compare& comp = Compare())
+        :   m_comp{ comp }
+    {
+        insert(std::move(keys), std::move(values));
+    }
+
+    flat_map(std::initializer_list<std::pair<Key, T>> entries, const Compare& comp = Compare())
+        :   m_comp{ comp }
+    {
+        vector<Key> keys{};
+        vector<T> values{};
+
+        keys.reserve(entries.size());
+        values.reserve(entries.size());
+
+        for (const std::pair<Key, T>& entry : entries)
+        {
+            keys.push_back(entry.first);
+            values.push_back(entry.second);
+        }
+
+        insert(std::move(keys), std::move(values));
+    }
+
+    auto size() const -> size_type
+    {
+        return this->m_keys.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return this->m_keys.empty();
+    }
+
+    auto reserve(size_type count) -> void
+    {
+        this->m_keys.reserve(count);
+        this->m_values.reserve(count);
+    }
+
+    auto clear() -> void
+    {
+        this->m_keys.clear();
+        this->m_values.clear();
+    }
+
+    ///
+    /// The sorted keys and the values in the same order
+    ///
+    auto keys() const -> const vector<Key>&
+    {
+        return this->m_keys;
+    }
+
+    auto values() const -> const vector<T>&
+    {
+        return this->m_values;
+    }
+
+    ///
+    /// Index of the first key not less than "key", size() if there is none
+    ///
+    auto lower_bound_index(const Key& key) const -> size_type
+    {
+        return detail::branchless_lower_bound(this->m_keys.data(), this->m_keys.size(), key, this->m_comp);
+    }
+
+    auto lower_bound(const Key& key) -> iterator { return { this, lower_bound_index(key) }; }
+    auto lower_bound(const Key& key) const -> const_iterator { return { this, lower_bound_index(key) }; }
+
+    auto find(const Key& key) -> iterator { return { this, find_index(key) }; }
+    auto find(const Key& key) const -> const_iterator { return { this, find_index(key) }; }
+
+    auto contains(const Key& key) const -> bool
+    {
+        return find_index(key) != size();
+    }
+
+    auto count(const Key& key) const -> size_type
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    ///
+    /// Value of "key", inserting a value initialized one if the key is not there yet
+    ///
+    auto operator[](const Key& key) -> T&
+    {
+        return emplace_at(lower_bound_index(key), key).first.value();
+    }
+
+    ///
+    /// Insert "key" with "value" if the key is not there yet. Returns the
+    /// position of the entry and whether it was inserted
+    ///
+    auto insert(const Key& key, const T& value) -> std::pair<iterator, bool>
+    {
+        return emplace_at(lower_bound_index(key), key, value);
+    }
+
+    auto insert(const Key& key, T&& value) -> std::pair<iterator, bool>
+    {
+        return emplace_at(lower_bound_index(key), key, std::move(value));
+    }
+
+    ///
+    /// Insert "key" with "value", replacing the value if the key is already there
+    ///
+    auto insert_or_assign(const Key& key, T value) -> std::pair<iterator, bool>
+    {
+        const size_type index{ lower_bound_index(key) };
+
+        if (matches(index, key))
+        {
+            this->m_values[index] = std::move(value);
+            return { iterator{ this, index }, false };
+        }
+
+        return emplace_at(index, key, std::move(value));
+    }
+
+    ///
+    /// Insert many entries at once. The new entries are sorted by key once
+    /// and merged with the map in one linear pass instead of shifting the
+    /// map once per entry. Keys already in the map keep their value, of
+    /// repeated new keys the first one wins. Returns the amount of inserted entries.
+    /// "keys" and "values" must have the same size, otherwise nothing is inserted
+    ///
+    auto insert(vector<Key>&& keys, vector<T>&& values) -> size_type
+    {
+        assert(keys.size() == values.size() and "every key needs exactly one value");
+
+        if (keys.size() != values.size())
+            return 0;
+
+        const size_type count{ keys.size() };
+
+        // sort positions rather than entries so keys and values move only once
+        vector<size_type> order{};
+        order.reserve(count);
+
+        for (size_type index{}; index < count; ++index)
+            order.push_back(index);
+
+        std::stable_sort(order.data(), order.data() + count, [&keys, this](size_type lhs, size_type rhs) -> bool
+        {
+            return this->m_comp(keys[lhs], keys[rhs]);
+        });
+
+        vector<Key> merged_keys{};
+        vector<T> merged_values{};
+
+        merged_keys.reserve(this->m_keys.size() + count);
+        merged_values.reserve(this->m_keys.size() + count);
+
+        size_type left{};
+        size_type right{};
+
+        const auto take_new{ [&](size_type position) -> void
+        {
+            // a repeated new key only differs from the last merged key
+            if (merged_keys.size() != 0 and not this->m_comp(merged_keys[merged_keys.size() - 1], keys[position]))
+                return;
+
+            merged_keys.push_back(std::move(keys[position]));
+            merged_values.push_back(std::move(values[position]));
+        } };
+
+        while (left < this->m_keys.size() and right < count)
+        {
+            const Key& new_key{ keys[order[right]] };
+
+            if (this->m_comp(this->m_keys[left], new_key))
+            {
+                merged_keys.push_back(std::move(this->m_keys[left]));
+                merged_values.push_back(std::move(this->m_values[left]));
+                ++left;
+            }
+            else if (this->m_comp(new_key, this->m_keys[left]))
+                take_new(order[right++]);
+            else
+                ++right;
+        }
+
+        for (; left < this->m_keys.size(); ++left)
+        {
+            merged_keys.push_back(std::move(this->m_keys[left]));
+            merged_values.push_back(std::move(this->m_values[left]));
+        }
+
+        for (; right < count; ++right)
+            take_new(order[right]);
+
+        const size_type inserted{ merged_keys.size() - this->m_keys.size() };
+
+        this->m_keys = std::move(merged_keys);
+        this->m_values = std::move(merged_values);
+
+        return inserted;
+    }
+
+    ///
+    /// Remove the entry of "key", returns the amount of removed entries
+    ///
+    auto erase(const Key& key) -> size_type
+    {
+        const size_type index{ find_index(key) };
+
+        if (index == size())
+            return 0;
+
+        this->m_keys.erase(this->m_keys.begin() + index);
+        this->m_values.erase(this->m_values.begin() + index);
+
+        return 1;
+    }
+
+    auto begin() -> iterator { return { this, 0 }; }
+    auto end() -> iterator { return { this, size() }; }
+    auto begin() const -> const_iterator { return { this, 0 }; }
+    auto end() const -> const_iterator { return { this, size() }; }
+    auto cbegin() const -> const_iterator { return begin(); }
+    auto cend() const -> const_iterator { return end(); }
+
+private:
+    auto matches(size_type index, const Key& key) const -> bool
+    {
+        return index != size() and not this->m_comp(key, this->m_keys[index]);
+    }
+
+    auto find_index(const Key& key) const -> size_type
+    {
+        const size_type index{ lower_bound_index(key) };
+        return matches(index, key) ? index : size();
+    }
+
+    ///
+    /// Insert "key" with a value built from "args" at "index", the position
+    /// lower_bound_index() returned for it, unless the key is already there.
+    /// Both vectors get their room first and a value that fails to go in takes
+    /// its key out again, the two vectors never differ in size
+    ///
+    template <typename... Args>
+    auto emplace_at(size_type index, const Key& key, Args&&... args) -> std::pair<iterator, bool>
+    {
+        if (matches(index, key))
+            return { iterator{ this, index }, false };
+
+        T value(std::forward<Args>(args)...);
+
+        const size_type count{ this->m_keys.size() };
+
+        if (count == this->m_keys.capacity() or count == this->m_values.capacity())
+        {
+            const size_type new_capacity{ vector<Key>::growth_policy::next_capacity(count, count + 1, sizeof(Key)) };
+
+            this->m_keys.reserve(new_capacity);
+            this->m_values.reserve(new_capacity);
+        }
+
+        this->m_keys.insert(this->m_keys.begin() + index, &key, &key + 1);
+
+        try
+        {
+            this->m_values.insert(this->m_values.begin() + index, std::make_move_iterator(&value),
+                std::make_move_iterator(&value + 1));
+        }
+        catch (...)
+        {
+            this->m_keys.erase(this->m_keys.begin() + index);
+            throw;
+        }
+
+        return { iterator{ this, index }, true };
+    }
+
+    vector<Key> m_keys{};
+    vector<T> m_values{};
+    Compare m_comp{};
+};
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef FLAT_SET_HH
+#define FLAT_SET_HH
+
+// C++ standard library includes
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+
+#include "vector.h"
+
+namespace kt
+{
+namespace detail
+{
+    ///
+    /// Index of the first of "count" sorted elements starting at "first"
+    /// that does not compare less than "key". Halves the range without a
+    /// data dependent branch, the compiler turns the step into a conditional
+    /// move, so lookups do not pay for mispredicted branches
+    ///
+    template <typename T, typename Key, typename Compare>
+    auto branchless_lower_bound(const T* first, std::size_t count, const Key& key, const Compare& comp) -> std::size_t
+    {
+        if (count == 0)
+            return 0;
+
+        const T* base{ first };
+
+        while (count > 1)
+        {
+            const std::size_t half{ count / 2 };
+
+            base = comp(base[half], key) ? base + half : base;
+            count -= half;
+        }
+
+        return static_cast<std::size_t>(base - first) + (comp(*base, key) ? 1 : 0);
+    }
+
+    ///
+    /// Sort "keys" and drop the repeated ones, keeping the first of each
+    ///
+    template <typename Key, typename Compare>
+    auto sort_unique(vector<Key>& keys, const Compare& comp) -> void
+    {
+        Key* const first{ keys.data() };
+        Key* const last{ first + keys.size() };
+
+        std::stable_sort(first, last, comp);
+
+        Key* const end{ std::unique(first, last, [&comp](const Key& lhs, const Key& rhs) -> bool
+        {
+            return not comp(lhs, rhs) and not comp(rhs, lhs);
+        }) };
+
+        keys.remove_n(static_cast<std::size_t>(last - end));
+    }
+}   // END KT::DETAIL NAMESPACE
+
+///
+/// Set of unique keys kept sorted in one kt::vector. Lookups are a binary
+/// search over contiguous memory, which beats chasing the nodes of a
+/// std::set for small and medium sizes; inserting one key shifts the ones
+/// after it, so bulk loads should go through the constructor or the
+/// batched insert, which sort the new keys once and merge them in
+///
+template <typename Key, typename Compare = std::less<Key>>
+class flat_set
+{
+public:
+    using key_type              = Key;
+    using value_type            = Key;
+    using key_compare           = Compare;
+    using size_type             = std::size_t;
+    using const_iterator        = typename vector<Key>::const_iterator;
+    using iterator              = const_iterator;
+
+    flat_set() = default;
+
+    explicit flat_set(const Compare& comp)
+        :   m_comp{ comp }
+    {
+
+    }
+
+    ///
+    /// Take the keys of "keys" in any order, they are sorted and deduplicated once
+    ///
+    explicit flat_set(vector<Key>&& keys, const Compare& comp = Compare())
+        :   m_keys{ std::move(keys) }, m_comp{ comp }
+    {
+        detail::sort_unique(this->m_keys, this->m_comp);
+    }
+
+    flat_set(std::initializer_list<Key> keys, const Compare& comp = Compare())
+        :   m_keys{}, m_comp{ comp }
+    {
+        this->m_keys.reserve(keys.size());
+
+        for (const Key& key : keys)
+            this->m_keys.push_back(key);
+
+        detail::sort_unique(this->m_keys, this->m_comp);
+    }
+
+    auto size() const -> size_type
+    {
+        return this->m_keys.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return this->m_keys.empty();
+    }
+
+    auto reserve(size_type count) -> void
+    {
+        this->m_keys.reserve(count);
+    }
+
+    auto clear() -> void
+    {
+        this->m_keys.clear();
+    }
+
+    ///
+    /// The sorted keys
+    ///
+    auto keys() const -> const vector<Key>&
+    {
+        return this->m_keys;
+    }
+
+    ///
+    /// Index of the first key not less than "key", size() if there is none
+    ///
+    auto lower_bound_index(const Key& key) const -> size_type
+    {
+        return detail::branchless_lower_bound(this->m_keys.data(), this->m_keys.size(), key, this->m_comp);
+    }
+
+    auto lower_bound(const Key& key) const -> const_iterator
+    {
+        return begin() + lower_bound_index(key);
+    }
+
+    auto find(const Key& key) const -> const_iterator
+    {
+        const size_type index{ lower_bound_index(key) };
+
+        return index != size() and not this->m_comp(key, this->m_keys[index]) ? begin() + index : end();
+    }
+
+    auto contains(const Key& key) const -> bool
+    {
+        return find(key) != end();
+    }
+
+    auto count(const Key& key) const -> size_type
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    ///
+    /// Insert "key" if it is not there yet. Returns the position of the key
+    /// and whether it was inserted
+    ///
+    auto insert(const Key& key) -> std::pair<const_iterator, bool>
+    {
+        const size_type index{ lower_bound_index(key) };
+
+        if (index != size() and not this->m_comp(key, this->m_keys[index]))
+            return { begin() + index, false };
+
+        this->m_keys.insert(this->m_keys.begin() + index, &key, &key + 1);
+
+        return { begin() + index, true };
+    }
+
+    ///
+    /// Insert many keys at once: they are sorted, deduplicated and merged with
+    /// the keys already in the set in one linear pass instead of shifting the
+    /// set once per key. Returns the amount of keys that were not there yet
+    ///
+    auto insert(vector<Key>&& keys) -> size_type
+    {
+        detail::sort_unique(keys, this->m_comp);
+
+        vector<Key> merged{};
+        merged.reserve(this->m_keys.size() + keys.size());
+
+        size_type left{};
+        size_type right{};
+
+        while (left < this->m_keys.size() and right < keys.size())
+        {
+            if (this->m_comp(this->m_keys[left], keys[right]))
+                merged.push_back(std::move(this->m_keys[left++]));
+            else if (this->m_comp(keys[right], this->m_keys[left]))
+                merged.push_back(std::move(keys[right++]));
+            else
+            {
+                merged.push_back(std::move(this->m_keys[left++]));
+                ++right;
+            }
+        }
+
+        for (; left < this->m_keys.size(); ++left)
+            merged.push_back(std::move(this->m_keys[left]));
+
+        for (; right < keys.size(); ++right)
+            merged.push_back(std::move(keys[right]));
+
+        const size_type inserted{ merged.size() - this->m_keys.size() };
+        this->m_keys = std::move(merged);
+
+        return inserted;
+    }
+
+    template <typename InputIt>
+    auto insert(InputIt first, InputIt last) -> size_type
+    {
+        vector<Key> keys{};
+
+        for (; first != last; ++first)
+            keys.push_back(*first);
+
+        return insert(std::move(keys));
+    }
+
+    ///
+    /// Remove "key", returns the amount of removed keys
+    ///
+    auto erase(const Key& key) -> size_type
+    {
+        const size_type index{ lower_bound_index(key) };
+
+        if (index == size() or this->m_comp(key, this->m_keys[index]))
+            return 0;
+
+        this->m_keys.erase(this->m_keys.begin() + index);
+
+        return 1;
+    }
+
+    auto begin() const -> const_iterator { return this->m_keys.begin(); }
+    auto end() const -> const_iterator { return this->m_keys.end(); }
+    auto cbegin() const -> const_iterator { return this->m_keys.cbegin(); }
+    auto cend() const -> const_iterator { return this->m_keys.cend(); }
+
+private:
+    vector<Key> m_keys{};
+    Compare m_comp{};
+};
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef GROWTH_POLICY_HH
+#define GROWTH_POLICY_HH
+
+// C++ standard library includes
+#include <cstddef>
+#include <algorithm>
+
+namespace kt
+{
+///
+/// Growth policies decide the capacity of the next block when a container
+/// runs out of room. Every policy provides
+///
+///     static auto next_capacity(std::size_t capacity, std::size_t required,
+///         std::size_t element_size) noexcept -> std::size_t
+///
+/// which returns a capacity of at least "required" elements
+///
+
+namespace detail
+{
+    // first block holds one cache line worth of elements instead of a single one
+    constexpr auto initial_capacity(std::size_t element_size) noexcept -> std::size_t
+    {
+        return element_size < 64 ? 64 / element_size : 1;
+    }
+
+    constexpr auto round_up(std::size_t value, std::size_t multiple) noexcept -> std::size_t
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+}
+
+///
+/// Doubles the capacity on every growth. Fewest reallocations, up to 50% of the block unused
+///
+struct grow_double
+{
+    static constexpr auto next_capacity(std::size_t capacity, std::size_t required,
+        std::size_t element_size) noexcept -> std::size_t
+    {
+        if (capacity == 0)
+            return std::max(required, detail::initial_capacity(element_size));
+
+        return std::max(required, capacity * 2);
+    }
+};
+
+///
+/// Grows by a factor of 1.5. More reallocations than grow_double but less
+/// memory overhead, and freed blocks can eventually be reused by the allocator
+///
+struct grow_golden
+{
+    static constexpr auto next_capacity(std::size_t capacity, std::size_t required,
+        std::size_t element_size) noexcept -> std::size_t
+    {
+        if (capacity == 0)
+            return std::max(required, detail::initial_capacity(element_size));
+
+        return std::max(required, capacity + capacity / 2 + 1);
+    }
+};
+
+///
+/// Doubles the capacity and, once blocks are bigger than a page, rounds the
+/// size of the block up to a whole number of pages so no partial page is wasted
+///
+template <std::size_t PageSize = 4096>
+struct grow_page_rounded
+{
+    static constexpr auto next_capacity(std::size_t capacity, std::size_t required,
+        std::size_t element_size) noexcept -> std::size_t
+    {
+        const std::size_t count{ grow_double::next_capacity(capacity, required, element_size) };
+
+        // rounding a block this big would wrap around, the allocation fails anyway
+        if (count > (static_cast<std::size_t>(-1) - PageSize) / element_size)
+            return count;
+
+        if (count * element_size < PageSize)
+            return count;
+
+        return detail::round_up(count * element_size, PageSize) / element_size;
+    }
+};
+
+///
+/// Doubles the capacity. The slack malloc adds to every block is not guessed
+/// here: an allocator with allocate_at_least, such as malloc_allocator, reports
+/// how many elements the block it handed out really holds and kt::vector
+/// takes that as its capacity
+///
+using grow_usable_size = grow_double;
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef INSTRUMENTATION_HH
+#define INSTRUMENTATION_HH
+
+///
+/// Opt-in allocation and growth instrumentation for kt::vector. Define
+/// KT_VECTOR_INSTRUMENTATION before including vector.h (or pass
+/// -DKT_VECTOR_INSTRUMENTATION) to enable it. When it is not defined every
+/// hook expands to nothing and vector.h does not depend on anything here.
+///
+/// Events are aggregated per element type. Wrapping code in a scope that starts
+/// with KT_VECTOR_SITE() additionally splits them per call site: every event
+/// raised by the current thread is attributed to the innermost active site
+///
+
+#if defined(KT_VECTOR_INSTRUMENTATION)
+
+// C++ standard library includes
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <typeinfo>
+#include <typeindex>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace kt::instrumentation
+{
+struct call_site
+{
+    const char* file;
+    unsigned line;
+    const char* function;
+};
+
+// capacities are bucketed by powers of two, final fill ratios by tenths
+inline constexpr std::size_t capacity_buckets{ 48 };
+inline constexpr std::size_t fill_buckets{ 11 };
+
+struct stats
+{
+    std::string type_name{};
+    const call_site* site{};
+    std::uint64_t allocations{};
+    std::uint64_t reallocations{};
+    std::uint64_t bytes_allocated{};
+    std::uint64_t bytes_copied{};
+    std::uint64_t vectors_destroyed{};
+    std::uint64_t final_size_total{};
+    std::uint64_t final_capacity_total{};
+    std::size_t peak_capacity{};
+    std::uint64_t capacity_histogram[capacity_buckets]{};
+    std::uint64_t fill_histogram[fill_buckets]{};
+};
+
+namespace detail
+{
+    struct registry
+    {
+        std::mutex lock;
+        std::map<std::pair<std::type_index, const call_site*>, stats> entries;
+    };
+
+    // never destroyed, vectors with static storage may still report while exiting
+    inline auto global_registry() -> registry&
+    {
+        static registry* instance{ new registry{} };
+        return *instance;
+    }
+
+    inline thread_local const call_site* current_site{ nullptr };
+
+    inline auto demangle(const char* name) -> std::string
+    {
+#if defined(__GNUG__)
+        int status{};
+        char* readable{ abi::__cxa_demangle(name, nullptr, nullptr, &status) };
+
+        if (status == 0 and readable)
+        {
+            std::string result{ readable };
+            std::free(readable);
+
+            return result;
+        }
+#endif
+        return name;
+    }
+
+    inline auto log2_bucket(std::size_t value) -> std::size_t
+    {
+        std::size_t bucket{};
+
+        while (value > 1 and bucket + 1 < capacity_buckets)
+        {
+            value >>= 1;
+            ++bucket;
+        }
+
+        return bucket;
+    }
+
+    // apply "update" to the stats of element type T at the current call site
+    template <typename T, typename Update>
+    auto record(Update&& update) -> void
+    {
+        registry& instance{ global_registry() };
+        const std::lock_guard<std::mutex> guard{ instance.lock };
+
+        auto [entry, inserted]{ instance.entries.try_emplace({ std::type_index{ typeid(T) }, current_site }) };
+
+        if (inserted)
+        {
+            entry->second.type_name = demangle(typeid(T).name());
+            entry->second.site = current_site;
+        }
+
+        update(entry->second);
+    }
+}
+
+///
+/// Attributes the events raised by the current thread to "site" while alive
+///
+class site_scope
+{
+public:
+    explicit site_scope(const call_site* site) noexcept
+        :   m_previous{ detail::current_site }
+    {
+        detail::current_site = site;
+    }
+
+    site_scope(const site_scope&) = delete;
+    site_scope& operator=(const site_scope&) = delete;
+
+    ~site_scope()
+    {
+        detail::current_site = this->m_previous;
+    }
+
+private:
+    const call_site* m_previous;
+};
+
+///
+/// A block for "count" elements was obtained from the allocator
+///
+template <typename T>
+auto on_allocate(std::size_t count) -> void
+{
+    detail::record<T>([count](stats& entry) -> void
+    {
+        entry.allocations += 1;
+        entry.bytes_allocated += count * sizeof(T);
+        entry.capacity_histogram[detail::log2_bucket(count)] += 1;
+
+        if (count > entry.peak_capacity)
+            entry.peak_capacity = count;
+    });
+}
+
+///
+/// The elements were moved from a block of "old_capacity" elements
+/// to one of "new_capacity", relocating "count" of them
+///
+template <typename T>
+auto on_reallocate(std::size_t old_capacity, std::size_t new_capacity, std::size_t count) -> void
+{
+    detail::record<T>([=](stats& entry) -> void
+    {
+        if (old_capacity != 0)
+            entry.reallocations += 1;
+
+        entry.bytes_copied += count * sizeof(T);
+
+        if (new_capacity > entry.peak_capacity)
+            entry.peak_capacity = new_capacity;
+    });
+}
+
+///
+/// "count" elements were copied into a vector
+///
+template <typename T>
+auto on_copy(std::size_t count) -> void
+{
+    detail::record<T>([count](stats& entry) -> void
+    {
+        entry.bytes_copied += count * sizeof(T);
+    });
+}
+
+///
+/// A vector holding "count" elements in a block of "capacity" was destroyed
+///
+template <typename T>
+auto on_destroy(std::size_t count, std::size_t capacity) -> void
+{
+    detail::record<T>([=](stats& entry) -> void
+    {
+        entry.vectors_destroyed += 1;
+        entry.final_size_total += count;
+        entry.final_capacity_total += capacity;
+
+        if (capacity != 0)
+            entry.fill_histogram[count * 10 / capacity] += 1;
+    });
+}
+
+///
+/// Copy of everything recorded so far, one entry per element type and call site
+///
+inline auto snapshot() -> std::vector<stats>
+{
+    detail::registry& instance{ detail::global_registry() };
+    const std::lock_guard<std::mutex> guard{ instance.lock };
+
+    std::vector<stats> result{};
+    result.reserve(instance.entries.size());
+
+    for (const auto& [key, entry] : instance.entries)
+        result.push_back(entry);
+
+    return result;
+}
+
+///
+/// Forget everything recorded so far
+///
+inline auto reset() -> void
+{
+    detail::registry& instance{ detail::global_registry() };
+    const std::lock_guard<std::mutex> guard{ instance.lock };
+
+    instance.entries.clear();
+}
+
+///
+/// Print the counters and histograms of every element type and call site to "out"
+///
+inline auto dump(std::FILE* out = stderr) -> void
+{
+    for (const stats& entry : snapshot())
+    {
+        if (entry.site)
+            std::fprintf(out, "kt::vector<%s> at %s:%u (%s)\n", entry.type_name.c_str(),
+                entry.site->file, entry.site->line, entry.site->function);
+        else
+            std::fprintf(out, "kt::vector<%s>\n", entry.type_name.c_str());
+
+        const double fill_ratio{ entry.final_capacity_total
+            ? static_cast<double>(entry.final_size_total) / static_cast<double>(entry.final_capacity_total) : 0.0 };
+
+        std::fprintf(out, "    allocations: %llu (%llu bytes), reallocations: %llu, bytes copied: %llu\n",
+            static_cast<unsigned long long>(entry.allocations), static_cast<unsigned long long>(entry.bytes_allocated),
+            static_cast<unsigned long long>(entry.reallocations), static_cast<unsigned long long>(entry.bytes_copied));
+        std::fprintf(out, "    peak capacity: %zu, vectors destroyed: %llu, final size/capacity: %.3f\n",
+            entry.peak_capacity, static_cast<unsigned long long>(entry.vectors_destroyed), fill_ratio);
+
+        std::fprintf(out, "    block capacity histogram:\n");
+        for (std::size_t bucket{}; bucket < capacity_buckets; ++bucket)
+            if (entry.capacity_histogram[bucket])
+                std::fprintf(out, "        [2^%zu, 2^%zu): %llu\n", bucket, bucket + 1,
+                    static_cast<unsigned long long>(entry.capacity_histogram[bucket]));
+
+        std::fprintf(out, "    final size/capacity histogram:\n");
+        for (std::size_t bucket{}; bucket < fill_buckets; ++bucket)
+            if (entry.fill_histogram[bucket])
+                std::fprintf(out, "        %3zu%%%s: %llu\n", bucket * 10, bucket + 1 < fill_buckets ? "+" : " ",
+                    static_cast<unsigned long long>(entry.fill_histogram[bucket]));
+    }
+}
+
+}   // END KT::INSTRUMENTATION NAMESPACE
+
+#define KT_INSTRUMENT(event) ::kt::instrumentation::event
+
+#define KT_VECTOR_SITE()                                                                            \
+    static const ::kt::instrumentation::call_site kt_vector_call_site{ __FILE__, __LINE__, __func__ };  \
+    const ::kt::instrumentation::site_scope kt_vector_site_scope{ &kt_vector_call_site }
+
+#else
+
+#define KT_INSTRUMENT(event) static_cast<void>(0)
+#define KT_VECTOR_SITE() static_cast<void>(0)
+
+#endif
+
+#endif
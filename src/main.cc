@@ -1,6 +1,30 @@
 #include "vector.h"
+#include "small_vector.h"
+#include "arena_allocator.h"
+#include "pool_allocator.h"
+#include "simd.h"
+#include "parallel.h"
+#include "concurrent_vector.h"
+#include "mmap_vector.h"
+#include "serialization.h"
+#include "soa_vector.h"
+#include "stable_vector.h"
+#include "aligned_allocator.h"
+#include "mremap_allocator.h"
+#include "malloc_allocator.h"
+#include "bit_vector.h"
+#include "flat_set.h"
+#include "flat_map.h"
+#include "static_vector.h"
+#include "shared_vector.h"
+#include "vector_view.h"
+#include "compressed_vector.h"
 #include <iostream>
+#include <algorithm>
 #include <memory>
+#include <sstream>
+#include <thread>
+#include <string>
 
 class Resource
 {
@@ -43,7 +67,16 @@ int main(int, char**)
     std::cout << std::endl;
 
     std::cout << "vector1.at(2): ";
-    vector1.at(2);
+
+    try
+    {
+        vector1.at(2);
+    }
+    catch (const kt::empty_vector& error)
+    {
+        std::cout << error.what();
+    }
+
     std::cout << std::endl;
 
     kt::vector<double>  doubles{ 1.3, 2.33, 5.11, -34.22, 5.22, 7.11 };
@@ -172,6 +205,33 @@ int main(int, char**)
 
     vec5.remove_n(7);
 
+    std::cout << "\n******* ERASE TEST *******\n";
+    kt::vector<int> readings{ 4, -1, 8, 15, -1, 16, 23, 42, -1 };
+
+    readings.erase(readings.begin());
+    const std::size_t invalid{ readings.erase_if([](int reading) -> bool { return reading < 0; }) };
+    readings.swap_remove(readings.begin());
+    readings.remove_indices({ 0, 2 });
+
+    std::cout << "removed " << invalid << " invalid readings, left:";
+
+    for (const auto& reading : readings)
+        std::cout << ' ' << reading;
+
+    std::cout << std::endl;
+
+    std::cout << "\n******* ITERATOR TEST *******\n";
+    kt::vector<int> unsorted{ 42, 7, 19, 3, 25 };
+    std::sort(unsorted.begin(), unsorted.end());
+
+    const auto found{ std::lower_bound(unsorted.cbegin(), unsorted.cend(), 19) };
+    std::cout << "19 at index " << found - unsorted.cbegin() << ", reversed:";
+
+    for (auto it{ unsorted.rbegin() }; it != unsorted.rend(); ++it)
+        std::cout << ' ' << *it;
+
+    std::cout << std::endl;
+
     std::cout << "******* CONCATENATE TEST *******\n";
     kt::vector<int> vec6{ 1, 2, 3, 4, 5 };
     kt::vector<int> vec7{ 2, 4, 6, 8, 10 };
@@ -198,12 +258,26 @@ int main(int, char**)
     for (const auto& it : vec_copy)
         std::cout << it << ' ';
 
-#if 0
+    std::cout << "\n******* TEST NON TRIVIAL ELEMENTS ********\n";
     kt::vector<std::unique_ptr<double>> ptrs{};
 
     for (int i = 0; i < 10; ++i)
         ptrs.push_back(std::make_unique<double>(4.5 * 3.0 * i));
-#endif
+
+    for (const auto& it : ptrs)
+        std::cout << *it << ' ';
+
+    std::cout << std::endl;
+
+    kt::vector<std::string> names{ "first", "second", "a string long enough to live on the heap" };
+
+    for (int i = 0; i < 10; ++i)
+        names.push_back(names[0]);
+
+    auto names_copy{ names };
+    names_copy.append(names);
+
+    std::cout << "names_copy size(): " << names_copy.size() << ", last: " << names_copy[names_copy.size() - 1] << std::endl;
 
     std::cout << "\n******* TEST EMPLACE_BACK ********\n";
     kt::vector<Resource> stuff{};
@@ -230,8 +304,337 @@ int main(int, char**)
     std::cout << "stuff size(): " << stuff.size() << std::endl;
     std::cout << "stuff capacity(): " << stuff.capacity() << std::endl;
 
+    std::cout << "\n******* TEST RESERVE, RESIZE AND SHRINK_TO_FIT ********\n";
+    kt::vector<int> presized{};
+    presized.reserve(1000);
+    std::cout << "after reserve(1000) size(): " << presized.size() << ", capacity(): " << presized.capacity() << std::endl;
+
+    presized.resize(10, 7);
+    presized.resize(12);
+    for (const auto& it : presized)
+        std::cout << it << ' ';
+
+    presized.shrink_to_fit();
+    std::cout << "\nafter shrink_to_fit() size(): " << presized.size() << ", capacity(): " << presized.capacity() << std::endl;
+
+    kt::vector<double, std::allocator<double>, kt::grow_golden> golden{};
+    kt::vector<double, kt::malloc_allocator<double>, kt::grow_usable_size> usable{};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        golden.push_back(i);
+        usable.push_back(i);
+    }
+
+    std::cout << "capacity for 1000 doubles, 1.5x: " << golden.capacity() << ", usable size: " << usable.capacity() << std::endl;
+
+    std::cout << "\n******* TEST BULK INSERTION ********\n";
+    kt::vector<int> decoded{};
+    decoded.resize_default_init(4);
+
+    for (std::size_t index{}; index < decoded.size(); ++index)
+        decoded[index] = static_cast<int>(index);
+
+    decoded.emplace_back_n(3, 9);
+    decoded.append(vec7.begin(), vec7.end());
+    decoded.insert(decoded.begin() + 1, vec6.begin(), vec6.begin() + 2);
+
+    decoded.reserve(decoded.size() + 2);
+    decoded.unchecked_push_back(-1);
+    decoded.unchecked_push_back(-2);
+
+    for (const auto& it : decoded)
+        std::cout << it << ' ';
+
+    std::cout << std::endl;
+
+    kt::vector<std::string> sources{ "moved", "into", "words" };
+    kt::vector<std::string> words{ "words:" };
+
+    words.append(std::make_move_iterator(sources.data()), std::make_move_iterator(sources.data() + sources.size()));
+    words.append(std::move(names));
+
+    std::cout << "words size(): " << words.size() << ", words[1]: " << words[1] << ", names size(): " << names.size() << std::endl;
+
+    std::cout << "\n******* TEST SMALL_VECTOR ********\n";
+    kt::small_vector<Resource, 4> few{};
+
+    few.emplace_back(1);
+    few.emplace_back(2);
+    std::cout << "few is inline: " << few.is_inline() << ", capacity(): " << few.capacity() << std::endl;
+
+    few.emplace_back(3);
+    few.emplace_back(4);
+    few.emplace_back(5);
+    std::cout << "few is inline: " << few.is_inline() << ", capacity(): " << few.capacity() << std::endl;
+
+    few.remove_n(3);
+    few.shrink_to_fit();
+    std::cout << "few is inline after shrink_to_fit(): " << few.is_inline() << std::endl;
+
+    std::cout << "\n******* TEST ARENA AND POOL ALLOCATORS ********\n";
+    kt::arena request_arena{};
+    kt::pool request_pool{};
+
+    for (int request = 0; request < 3; ++request)
+    {
+        {
+            KT_VECTOR_SITE();
+            kt::vector<int, kt::arena_allocator<int>> ids{ kt::arena_allocator<int>(request_arena) };
+            kt::vector<double, kt::pool_allocator<double>> costs{ kt::pool_allocator<double>(request_pool) };
+
+            for (int i = 0; i < 100; ++i)
+            {
+                ids.push_back(request * 100 + i);
+                costs.push_back(0.5 * i);
+            }
+
+            auto ids_copy{ ids };
+            std::cout << "request " << request << ": ids " << ids_copy.size() << ", costs " << costs.size()
+                      << ", arena bytes in use " << request_arena.bytes_allocated() << std::endl;
+        }
+
+        // everything the vectors of this request obtained goes away at once
+        request_arena.reset();
+    }
+
+    std::cout << "\n******* TEST SIMD KERNELS ********\n";
+    kt::vector<float> metrics{};
+
+    for (int i = 0; i < 1000; ++i)
+        metrics.push_back(0.25f * static_cast<float>(i % 40) - 2.0f);
+
+    std::cout << "sum: " << kt::simd::sum(metrics) << ", min: " << kt::simd::min(metrics)
+              << ", max: " << kt::simd::max(metrics) << ", dot: " << kt::simd::dot(metrics, metrics) << std::endl;
+
+    kt::simd::clamp(metrics, -1.0f, 1.0f);
+    kt::simd::scale(metrics, 2.0f);
+    std::cout << "after clamp and scale, min: " << kt::simd::min(metrics) << ", max: " << kt::simd::max(metrics) << std::endl;
+
+    std::cout << "numbers: find(111): " << kt::simd::find(numbers, std::size_t{ 111 })
+              << ", count(44): " << kt::simd::count(numbers, std::size_t{ 44 }) << std::endl;
+
+    std::cout << "\n******* TEST PARALLEL ALGORITHMS ********\n";
+    kt::vector<long> samples{};
+
+    for (long i = 0; i < 100000; ++i)
+        samples.push_back((i * 7919) % 1000);
+
+    kt::vector<long> squares{};
+    kt::parallel::transform(samples, squares, [](long value) -> long { return value * value; });
+    kt::parallel::sort(samples);
+    kt::parallel::inclusive_scan(squares);
+
+    std::cout << "sum: " << kt::parallel::reduce(samples, 0L) << ", smallest: " << samples[0]
+              << ", biggest: " << samples[samples.size() - 1] << ", sum of squares: " << squares[squares.size() - 1]
+              << std::endl;
+
+    std::cout << "\n******* TEST CONCURRENT_VECTOR ********\n";
+    kt::concurrent_vector<std::string> events{};
+    kt::vector<std::thread> producers{};
+
+    for (int producer = 0; producer < 4; ++producer)
+        producers.emplace_back([&events, producer]() -> void
+        {
+            for (int event = 0; event < 1000; ++event)
+                events.push_back("producer " + std::to_string(producer) + " event " + std::to_string(event));
+        });
+
+    for (auto& producer : producers)
+        producer.join();
+
+    std::cout << "events size(): " << events.size() << ", published: " << events.published_size()
+              << ", events[0]: " << events[0] << std::endl;
+
+    std::cout << "\n******* TEST MMAP_VECTOR ********\n";
+    {
+        kt::mmap_vector<std::size_t> table{ "lookup_table.bin", kt::map_mode::create };
 
+        for (std::size_t index{}; index < 1000; ++index)
+            table.push_back(index * index);
 
+        table.flush();
+    }
+    {
+        const kt::mmap_vector<std::size_t> table{ "lookup_table.bin", kt::map_mode::read_only };
+
+        std::cout << "reopened table size(): " << table.size() << ", table[999]: " << table[999] << std::endl;
+    }
+    std::remove("lookup_table.bin");
+
+    std::cout << "\n******* TEST SERIALIZATION ********\n";
+    std::stringstream checkpoint{};
+    kt::vector<double> restored{};
+
+    const kt::io_status written{ kt::write_to(checkpoint, reales) };
+    const kt::io_status read{ kt::read_from(checkpoint, restored) };
+
+    std::cout << "write: " << kt::to_string(written) << ", read: " << kt::to_string(read)
+              << ", restored size(): " << restored.size() << ", restored[2]: " << restored[2] << std::endl;
+
+    std::cout << "\n******* TEST SOA_VECTOR ********\n";
+    kt::soa_vector<float, float, std::string> particles{};
+
+    for (int index{}; index < 10; ++index)
+        particles.emplace_back(static_cast<float>(index), 0.5f * static_cast<float>(index), "p" + std::to_string(index));
+
+    const auto masses{ particles.column<1>() };
+    const auto [position, mass, name] = particles[4];
+
+    std::cout << "size(): " << particles.size() << ", total mass: " << kt::simd::sum(masses.data(), masses.size())
+              << ", row 4: " << position << " " << mass << " " << name << std::endl;
+
+    std::cout << "\n******* TEST STABLE_VECTOR ********\n";
+    kt::stable_vector<std::string> log_lines{ "first line" };
+    const std::string* const first_line{ &log_lines[0] };
+
+    for (int index{}; index < 1000; ++index)
+        log_lines.push_back("line " + std::to_string(index));
+
+    std::cout << "size(): " << log_lines.size() << ", capacity(): " << log_lines.capacity()
+              << ", first element moved: " << std::boolalpha << (first_line != &log_lines[0])
+              << std::noboolalpha << ", last: " << *(log_lines.end() - 1) << std::endl;
+
+    std::cout << "\n******* TEST ALIGNED ALLOCATORS ********\n";
+    kt::vector<float, kt::aligned_allocator<float, 64>> aligned_samples(1000);
+    kt::vector<double, kt::huge_page_allocator<double>, kt::grow_page_rounded<kt::huge_page_size>> big_table{};
+    big_table.reserve(1024 * 1024);
+
+    std::cout << "aligned_samples offset in cache line: " << reinterpret_cast<std::uintptr_t>(aligned_samples.data()) % kt::cache_line_size
+              << ", big_table offset in huge page: " << reinterpret_cast<std::uintptr_t>(big_table.data()) % kt::huge_page_size
+              << ", big_table capacity(): " << big_table.capacity() << std::endl;
+
+    std::cout << "\n******* TEST MREMAP_ALLOCATOR ********\n";
+    kt::vector<std::uint64_t, kt::mremap_allocator<std::uint64_t>, kt::grow_page_rounded<>> ids{};
+
+    for (std::uint64_t id{}; id < 1'000'000; ++id)
+        ids.push_back(id);
+
+    std::cout << "size(): " << ids.size() << ", capacity(): " << ids.capacity() << ", ids[999999]: " << ids[999'999] << std::endl;
+
+    std::cout << "\n******* TEST BIT_VECTOR ********\n";
+    kt::bit_vector enabled(200);
+    kt::bit_vector rolled_out(200);
+
+    enabled.set(10, 150);
+    rolled_out.set(100, 200);
+    rolled_out[3] = true;
+
+    const kt::bit_vector active{ enabled & rolled_out };
+
+    std::cout << "enabled: " << enabled.count() << ", rolled out: " << rolled_out.count() << ", active: " << active.count()
+              << ", first active: " << active.find_first() << ", next: " << active.find_next(active.find_first()) << std::endl;
+
+    std::cout << "\n******* TEST FLAT_SET / FLAT_MAP ********\n";
+    kt::flat_set<int> ports{ 443, 80, 8080, 80 };
+    ports.insert(22);
+    std::cout << "inserted: " << ports.insert({ 8080, 3000, 22, 5432 }) << ", ports:";
+
+    for (const int port : ports)
+        std::cout << ' ' << port;
+
+    std::cout << ", contains 3000: " << std::boolalpha << ports.contains(3000) << std::noboolalpha << std::endl;
+
+    kt::flat_map<std::string, int> stock{ { "pear", 4 }, { "apple", 10 }, { "fig", 2 } };
+    stock["kiwi"] += 7;
+    stock.insert_or_assign("fig", 0);
+    stock.erase("pear");
+
+    for (const auto [fruit, amount] : stock)
+        std::cout << fruit << ": " << amount << "  ";
+
+    std::cout << std::endl;
+
+    std::cout << "\n******* TEST STATIC_VECTOR ********\n";
+    constexpr auto powers_of_three{ []() -> kt::static_vector<std::uint64_t, 16>
+    {
+        kt::static_vector<std::uint64_t, 16> table{};
+
+        for (std::uint64_t power{ 1 }; table.push_back(power); power *= 3) { }
+
+        return table;
+    }() };
+
+    static_assert(powers_of_three.full() and powers_of_three[4] == 81);
+
+    kt::static_vector<std::string, 2, kt::overflow_throw> pending{ "tick", "tock" };
+
+    try
+    {
+        pending.push_back("overflow");
+    }
+    catch (const kt::capacity_exceeded& full)
+    {
+        std::cout << full.what();
+    }
+
+    std::cout << "3^15: " << powers_of_three[15] << ", pending: " << pending.size() << '/' << pending.capacity() << std::endl;
+
+    std::cout << "\n******* TEST SHARED_VECTOR ********\n";
+    kt::vector<std::string> settings{ "retries=3", "timeout=30", "verbose=false" };
+    const kt::shared_vector<std::string> published{ kt::freeze(std::move(settings)) };
+
+    kt::shared_vector<std::string> reader_a{ published };
+    kt::shared_vector<std::string> reader_b{ published };
+    std::cout << "sharing before write: " << published.use_count();
+
+    reader_b.edit()[2] = "verbose=true";
+    std::cout << ", after write: " << published.use_count() << ", published: " << published[2]
+              << ", reader_b: " << reader_b[2] << std::endl;
+
+    std::cout << "\n******* TEST VECTOR_VIEW ********\n";
+    kt::vector<int> samples_window{ 3, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+    const kt::vector_view<int> window{ samples_window };
+    const auto [head, tail] = window.split_at(4);
+
+    for (int& sample : tail.first(3))
+        sample = -sample;
+
+    std::cout << "head back: " << head.back() << ", tail: " << tail.size() << ", chunk sizes:";
+
+    for (const kt::vector_view<int> chunk : window.chunks(4))
+        std::cout << ' ' << chunk.size();
+
+    std::cout << ", samples_window[5]: " << samples_window[5] << std::endl;
+
+    std::cout << "\n******* TEST ERROR POLICIES ********\n";
+    kt::vector<int, std::allocator<int>, kt::grow_double, kt::errors_unchecked> gauges{};
+
+    for (int gauge{}; gauge < 4; ++gauge)
+        if (not gauges.try_push_back(gauge * 10))
+            std::cout << "could not store gauge " << gauge << '\n';
+
+    const int* missing{ gauges.try_at(7) };
+    std::cout << "gauges.try_at(2): " << *gauges.try_at(2) << ", gauges.try_at(7) is null: " << std::boolalpha
+              << (missing == nullptr) << std::noboolalpha;
+
+    try
+    {
+        samples_window.at(samples_window.size());
+    }
+    catch (const kt::out_of_bounds& error)
+    {
+        std::cout << ", samples_window.at(size()): " << error.what();
+    }
+
+    std::cout << std::endl;
+
+    std::cout << "\n******* TEST COMPRESSED_VECTOR ********\n";
+    kt::compressed_vector<std::size_t> event_times{};
+
+    for (std::size_t event{}; event < 1000; ++event)
+        event_times.push_back(1'700'000'000'000 + event * 250 + event % 7);
+
+    std::cout << "events: " << event_times.size() << ", bytes: " << event_times.memory_bytes()
+              << " instead of " << event_times.size() * sizeof(std::size_t) << ", event_times[500]: " << event_times[500]
+              << ", first event at or after 1700000100000: " << event_times.lower_bound(1'700'000'100'000) << std::endl;
+
+
+
+#if defined(KT_VECTOR_INSTRUMENTATION)
+    std::cout << "\n******* INSTRUMENTATION REPORT ********\n" << std::flush;
+    kt::instrumentation::dump(stdout);
+#endif
 
     std::cout << "\nFinishing program..." << std::endl;
     std::cout << std::endl;
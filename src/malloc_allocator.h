@@ -0,0 +1,116 @@
+#ifndef MALLOC_ALLOCATOR_HH
+#define MALLOC_ALLOCATOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#endif
+
+namespace kt
+{
+///
+/// Block returned by allocate_at_least: "ptr" holds room for "count"
+/// elements, at least as many as requested. Same layout as C++23's
+/// std::allocation_result
+///
+template <typename Pointer>
+struct allocation_result
+{
+    Pointer ptr;
+    std::size_t count;
+};
+
+///
+/// Allocator on top of malloc that reports the slack malloc adds to every
+/// block. allocate_at_least() asks the C library how big the block it just
+/// returned really is, malloc_usable_size() on Linux and malloc_size() on
+/// Apple platforms, and kt::vector takes that as its capacity, so the slack
+/// becomes room for elements without a second allocation. Elsewhere the
+/// block is reported at its requested size
+///
+template <typename T>
+class malloc_allocator
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+        "malloc_allocator does not support over-aligned element types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    malloc_allocator() noexcept = default;
+
+    template <typename U>
+    malloc_allocator(const malloc_allocator<U>&) noexcept { }
+
+    ///
+    /// Returns a block for "count" elements, throws std::bad_alloc if there is no memory
+    ///
+    auto allocate(std::size_t count) -> T*
+    {
+        return allocate_at_least(count).ptr;
+    }
+
+    ///
+    /// Returns a block for at least "count" elements together with the amount
+    /// of elements it can really hold, which is what deallocate() expects back
+    ///
+    auto allocate_at_least(std::size_t count) -> allocation_result<T*>
+    {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_alloc{};
+
+        const std::size_t bytes{ count != 0 ? count * sizeof(T) : 1 };
+        void* const block{ std::malloc(bytes) };
+
+        if (not block)
+            throw std::bad_alloc{};
+
+        const std::size_t usable{ usable_size(block, bytes) / sizeof(T) };
+
+        return { static_cast<T*>(block), usable > count ? usable : count };
+    }
+
+    auto deallocate(T* block, std::size_t) noexcept -> void
+    {
+        std::free(block);
+    }
+
+private:
+    static auto usable_size(void* block, std::size_t bytes) noexcept -> std::size_t
+    {
+#if defined(__APPLE__)
+        static_cast<void>(bytes);
+        return malloc_size(block);
+#elif defined(__linux__)
+        static_cast<void>(bytes);
+        return malloc_usable_size(block);
+#else
+        static_cast<void>(block);
+        return bytes;
+#endif
+    }
+};
+
+template <typename T, typename U>
+auto operator==(const malloc_allocator<T>&, const malloc_allocator<U>&) noexcept -> bool
+{
+    return true;
+}
+
+template <typename T, typename U>
+auto operator!=(const malloc_allocator<T>&, const malloc_allocator<U>&) noexcept -> bool
+{
+    return false;
+}
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,524 @@
+#ifndef MMAP_VECTOR_HH
+#define MMAP_VECTOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "vector.h"
+#include "error_policy.h"
+#include "growth_policy.h"
+
+namespace kt
+{
+///
+/// How a mmap_vector opens its file
+///
+enum class map_mode
+{
+    create,         // start empty, truncating an existing file
+    read_write,     // keep the elements stored in the file and allow appending
+    read_only       // map the stored elements without copying, no modification allowed
+};
+
+///
+/// Vector of trivially copyable elements stored in a memory-mapped file.
+///
+/// The file starts with a 64 byte header (magic, format version, element
+/// size and element count) followed by the elements exactly as they are
+/// laid out in memory, so opening an existing file is a single mmap and the
+/// elements are used in place. Growing extends the file with ftruncate and
+/// remaps it. The capacity beyond size() is trimmed from the file on close.
+///
+/// Changes reach the file through the page cache; call flush() to wait
+/// until they are on disk. The file is only portable between machines
+/// with the same endianness and layout of T.
+///
+/// Members that modify the vector do nothing while it is closed or read
+/// only, check is_open() and is_read_only() first
+///
+template <typename T, typename Growth = grow_page_rounded<>, typename Errors = errors_throw>
+class mmap_vector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "mmap_vector stores its elements as raw bytes");
+    static_assert(alignof(T) <= 64, "elements are stored 64 bytes into the file");
+
+public:
+    using value_type            = T;
+    using growth_policy         = Growth;
+    using error_policy          = Errors;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    // same iterators as kt::vector so both containers can be used interchangeably
+    using iterator              = typename vector<T>::iterator;
+    using const_iterator        = typename vector<T>::const_iterator;
+
+    static constexpr std::uint32_t format_version{ 1 };
+
+    ///
+    /// Closed vector, see is_open()
+    ///
+    mmap_vector() = default;
+
+    ///
+    /// Open or create the file at "path". On failure an error is written to
+    /// stderr and is_open() returns false
+    ///
+    explicit mmap_vector(const char* path, map_mode mode = map_mode::read_write)
+        :   m_mode{ mode }
+    {
+        const int flags{ mode == map_mode::read_only ? O_RDONLY
+            : mode == map_mode::create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR | O_CREAT };
+
+        this->m_fd = ::open(path, flags | O_CLOEXEC, 0644);
+
+        if (this->m_fd < 0)
+        {
+            std::fprintf(stderr, "could not open %s\n", path);
+            return;
+        }
+
+        struct stat info{};
+
+        if (::fstat(this->m_fd, &info) != 0)
+        {
+            std::fprintf(stderr, "could not stat %s\n", path);
+            close();
+            return;
+        }
+
+        const auto file_size{ static_cast<size_type>(info.st_size) };
+
+        if (file_size == 0 and mode != map_mode::read_only)
+        {
+            if (not map_file(0))
+            {
+                close();
+                return;
+            }
+
+            header() = file_header{};
+            return;
+        }
+
+        if (file_size < sizeof(file_header) or not map_existing(file_size))
+        {
+            std::fprintf(stderr, "%s is not a mmap_vector file\n", path);
+            close();
+            return;
+        }
+    }
+
+    mmap_vector(const mmap_vector&) = delete;
+    mmap_vector& operator=(const mmap_vector&) = delete;
+
+    mmap_vector(mmap_vector&& other) noexcept
+        :   m_fd{ std::exchange(other.m_fd, -1) }
+        ,   m_mode{ other.m_mode }
+        ,   m_mapping{ std::exchange(other.m_mapping, nullptr) }
+        ,   m_mapping_size{ std::exchange(other.m_mapping_size, 0) }
+        ,   m_capacity{ std::exchange(other.m_capacity, 0) }
+    {
+
+    }
+
+    auto operator=(mmap_vector&& other) noexcept -> mmap_vector&
+    {
+        if (this != &other)
+        {
+            close();
+
+            this->m_fd = std::exchange(other.m_fd, -1);
+            this->m_mode = other.m_mode;
+            this->m_mapping = std::exchange(other.m_mapping, nullptr);
+            this->m_mapping_size = std::exchange(other.m_mapping_size, 0);
+            this->m_capacity = std::exchange(other.m_capacity, 0);
+        }
+
+        return *this;
+    }
+
+    ~mmap_vector()
+    {
+        close();
+    }
+
+    auto is_open() const -> bool
+    {
+        return this->m_mapping != nullptr;
+    }
+
+    auto is_read_only() const -> bool
+    {
+        return this->m_mode == map_mode::read_only;
+    }
+
+    ///
+    /// Returns the amount of elements in the vector
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_mapping ? static_cast<size_type>(header().count) : 0;
+    }
+
+    ///
+    /// Returns the amount of elements the file has room for
+    ///
+    auto capacity() const -> size_type
+    {
+        return this->m_capacity;
+    }
+
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+    ///
+    /// Returns a reference to the element at "index", no bounds checking.
+    /// Must not be used to modify a read only vector
+    ///
+    auto operator[](size_type index) -> reference_type
+    {
+        return data()[index];
+    }
+
+    auto operator[](size_type index) const -> const_reference_type
+    {
+        return data()[index];
+    }
+
+    auto data() -> pointer_type
+    {
+        return this->m_mapping ? reinterpret_cast<pointer_type>(this->m_mapping + sizeof(file_header)) : nullptr;
+    }
+
+    auto data() const -> const T*
+    {
+        return const_cast<mmap_vector*>(this)->data();
+    }
+
+    ///
+    /// Make room in the file for "count" elements
+    ///
+    auto reserve(size_type count) -> void
+    {
+        if (count > this->m_capacity and writable())
+            grow(count);
+    }
+
+    ///
+    /// Adjust the vector to contain "count" elements, new ones are value initialized
+    ///
+    auto resize(size_type count) -> void
+    {
+        if (not writable())
+            return;
+
+        const size_type current{ size() };
+
+        if (count > this->m_capacity and not grow(count))
+            return;
+
+        for (size_type index{ current }; index < count; ++index)
+            ::new (static_cast<void*>(data() + index)) T{};
+
+        header().count = count;
+    }
+
+    ///
+    /// Construct an element at the end of the vector
+    ///
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        if (not writable())
+            return;
+
+        const size_type count{ size() };
+
+        if (count == this->m_capacity and not grow(Growth::next_capacity(this->m_capacity, count + 1, sizeof(T))))
+            return;
+
+        if constexpr (std::is_constructible_v<T, Args&&...>)
+            ::new (static_cast<void*>(data() + count)) T(std::forward<Args>(args)...);
+        else
+            ::new (static_cast<void*>(data() + count)) T{ std::forward<Args>(args)... };
+
+        header().count = count + 1;
+    }
+
+    auto push_back(const_reference_type value) -> void
+    {
+        emplace_back(value);
+    }
+
+    ///
+    /// Append "count" elements from "source" with a single copy
+    ///
+    auto append(const T* source, size_type count) -> void
+    {
+        if (not writable() or count == 0)
+            return;
+
+        const size_type current{ size() };
+
+        if (current + count > this->m_capacity
+            and not grow(Growth::next_capacity(this->m_capacity, current + count, sizeof(T))))
+            return;
+
+        std::memcpy(static_cast<void*>(data() + current), source, count * sizeof(T));
+        header().count = current + count;
+    }
+
+    auto pop_back() -> void
+    {
+        if (writable() and size() != 0)
+            header().count -= 1;
+    }
+
+    auto clear() -> void
+    {
+        if (writable())
+            header().count = 0;
+    }
+
+    ///
+    /// Block until every change made so far is written to the file
+    ///
+    auto flush() -> bool
+    {
+        if (not this->m_mapping or is_read_only())
+            return false;
+
+        if (::msync(this->m_mapping, this->m_mapping_size, MS_SYNC) != 0)
+        {
+            std::fprintf(stderr, "could not flush mapped file\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    ///
+    /// Unmap the file, trimming the unused capacity from it first
+    ///
+    auto close() -> void
+    {
+        if (this->m_mapping)
+        {
+            const size_type used_bytes{ sizeof(file_header) + size() * sizeof(T) };
+
+            ::munmap(this->m_mapping, this->m_mapping_size);
+
+            if (not is_read_only() and ::ftruncate(this->m_fd, static_cast<off_t>(used_bytes)) != 0)
+                std::fprintf(stderr, "could not trim mapped file\n");
+        }
+
+        if (this->m_fd >= 0)
+            ::close(this->m_fd);
+
+        this->m_fd = -1;
+        this->m_mapping = nullptr;
+        this->m_mapping_size = 0;
+        this->m_capacity = 0;
+    }
+
+    ///
+    /// Returns an iterator to the beginning of the vector
+    ///
+    auto begin() -> iterator
+    {
+        return iterator{ data() };
+    }
+
+    ///
+    /// Returns an iterator to the element past of the vector
+    ///
+    auto end() -> iterator
+    {
+        return iterator{ data() + size() };
+    }
+
+    auto begin() const -> const_iterator
+    {
+        return const_iterator{ data() };
+    }
+
+    auto end() const -> const_iterator
+    {
+        return const_iterator{ data() + size() };
+    }
+
+    auto cbegin() const -> const_iterator
+    {
+        return begin();
+    }
+
+    auto cend() const -> const_iterator
+    {
+        return end();
+    }
+
+private:
+    // 64 bytes so the elements that follow are aligned for any reasonable T
+    struct file_header
+    {
+        char magic[8]{ 'K', 'T', 'M', 'M', 'V', 'E', 'C', '\0' };
+        std::uint32_t version{ format_version };
+        std::uint32_t element_size{ sizeof(T) };
+        std::uint64_t count{};
+        std::uint8_t reserved[40]{};
+    };
+
+    static_assert(sizeof(file_header) == 64, "the header layout is part of the file format");
+
+    auto header() -> file_header&
+    {
+        return *reinterpret_cast<file_header*>(this->m_mapping);
+    }
+
+    auto header() const -> const file_header&
+    {
+        return *reinterpret_cast<const file_header*>(this->m_mapping);
+    }
+
+    // modifying a closed or read-only vector is a no-op, see is_open() and is_read_only()
+    auto writable() const -> bool
+    {
+        return this->m_mapping and not is_read_only();
+    }
+
+    static auto bytes_for(size_type capacity) -> size_type
+    {
+        return sizeof(file_header) + capacity * sizeof(T);
+    }
+
+    // size the file to hold "capacity" elements and map all of it
+    auto map_file(size_type capacity) -> bool
+    {
+        const size_type bytes{ bytes_for(capacity) };
+
+        if (::ftruncate(this->m_fd, static_cast<off_t>(bytes)) != 0)
+            return false;
+
+        void* const mapping{ ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_fd, 0) };
+
+        if (mapping == MAP_FAILED)
+            return false;
+
+        this->m_mapping = static_cast<unsigned char*>(mapping);
+        this->m_mapping_size = bytes;
+        this->m_capacity = capacity;
+
+        return true;
+    }
+
+    // map a file written before and check that its header matches T
+    auto map_existing(size_type file_size) -> bool
+    {
+        const int protection{ is_read_only() ? PROT_READ : PROT_READ | PROT_WRITE };
+        void* const mapping{ ::mmap(nullptr, file_size, protection, MAP_SHARED, this->m_fd, 0) };
+
+        if (mapping == MAP_FAILED)
+            return false;
+
+        this->m_mapping = static_cast<unsigned char*>(mapping);
+        this->m_mapping_size = file_size;
+        this->m_capacity = (file_size - sizeof(file_header)) / sizeof(T);
+
+        const file_header expected{};
+        const file_header& stored{ header() };
+
+        if (std::memcmp(stored.magic, expected.magic, sizeof(expected.magic)) != 0
+            or stored.version != format_version or stored.element_size != sizeof(T)
+            or stored.count > this->m_capacity)
+        {
+            ::munmap(this->m_mapping, this->m_mapping_size);
+            this->m_mapping = nullptr;
+            this->m_mapping_size = 0;
+            this->m_capacity = 0;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    ///
+    /// remap() handing a failure to the error policy, growing the file is
+    /// how this vector allocates
+    ///
+    auto grow(size_type capacity) -> bool
+    {
+        if (remap(capacity))
+            return true;
+
+        Errors::on_allocation_failure("could not grow the mapped file...");
+        return false;
+    }
+
+    ///
+    /// Grow the file to hold "capacity" elements and map the new size.
+    /// On Linux the mapping is extended in place or moved by the kernel
+    /// without copying, elsewhere the file is unmapped and mapped again
+    ///
+    auto remap(size_type capacity) -> bool
+    {
+        const size_type bytes{ bytes_for(capacity) };
+
+        if (::ftruncate(this->m_fd, static_cast<off_t>(bytes)) != 0)
+            return false;
+
+#if defined(__linux__)
+        void* const mapping{ ::mremap(this->m_mapping, this->m_mapping_size, bytes, MREMAP_MAYMOVE) };
+#else
+        ::munmap(this->m_mapping, this->m_mapping_size);
+        void* const mapping{ ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_fd, 0) };
+#endif
+
+        if (mapping == MAP_FAILED)
+        {
+#if defined(__linux__)
+            // the old mapping is untouched, keep the file at its size
+            if (::ftruncate(this->m_fd, static_cast<off_t>(this->m_mapping_size)) != 0)
+                std::fprintf(stderr, "could not restore mapped file size\n");
+#else
+            this->m_mapping = nullptr;
+            this->m_mapping_size = 0;
+            this->m_capacity = 0;
+#endif
+            return false;
+        }
+
+        this->m_mapping = static_cast<unsigned char*>(mapping);
+        this->m_mapping_size = bytes;
+        this->m_capacity = capacity;
+
+        return true;
+    }
+
+    int m_fd{ -1 };
+    map_mode m_mode{ map_mode::read_write };
+    unsigned char* m_mapping{};
+    size_type m_mapping_size{};
+    size_type m_capacity{};
+};
+
+}   // END KT NAMESPACE
+
+#endif
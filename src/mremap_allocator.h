@@ -0,0 +1,139 @@
+#ifndef MREMAP_ALLOCATOR_HH
+#define MREMAP_ALLOCATOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// POSIX includes
+#include <sys/mman.h>
+
+#include "growth_policy.h"
+
+namespace kt
+{
+///
+/// Allocator that lets big blocks grow without copying them. Blocks of at
+/// least "Threshold" bytes get their own anonymous mapping, rounded up to
+/// whole pages, and reallocate() resizes that mapping with
+/// mremap(MREMAP_MAYMOVE): the kernel moves page table entries instead of
+/// bytes, so growing a vector of gigabytes takes microseconds. Smaller
+/// blocks come from the global heap like with std::allocator.
+///
+/// kt::vector calls reallocate() on its own for trivially relocatable
+/// element types, see can_reallocate_in_place. Without mremap, outside of
+/// Linux, reallocate() always refuses and the vector copies as usual
+///
+template <typename T, std::size_t Threshold = 1024 * 1024>
+class mremap_allocator
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+        "mremap_allocator does not support over-aligned element types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t threshold{ Threshold };
+    static constexpr std::size_t page_size{ 4096 };
+
+    template <typename U>
+    struct rebind
+    {
+        using other = mremap_allocator<U, Threshold>;
+    };
+
+    mremap_allocator() noexcept = default;
+
+    template <typename U>
+    mremap_allocator(const mremap_allocator<U, Threshold>&) noexcept { }
+
+    ///
+    /// Returns a block for "count" elements, throws std::bad_alloc if there is no memory
+    ///
+    auto allocate(std::size_t count) -> T*
+    {
+        if (count > (static_cast<std::size_t>(-1) - page_size) / sizeof(T))
+            throw std::bad_alloc{};
+
+        const std::size_t bytes{ count * sizeof(T) };
+
+        if (not is_mapped(bytes))
+            return static_cast<T*>(::operator new(bytes));
+
+        void* const mapping{ ::mmap(nullptr, mapping_size(bytes), PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+
+        if (mapping == MAP_FAILED)
+            throw std::bad_alloc{};
+
+        return static_cast<T*>(mapping);
+    }
+
+    auto deallocate(T* block, std::size_t count) noexcept -> void
+    {
+        const std::size_t bytes{ count * sizeof(T) };
+
+        if (is_mapped(bytes))
+            ::munmap(static_cast<void*>(block), mapping_size(bytes));
+        else
+            ::operator delete(static_cast<void*>(block));
+    }
+
+    ///
+    /// Resize a block of "old_count" elements to "new_count" elements keeping
+    /// its bytes, possibly at a new address. Returns the block, or nullptr
+    /// leaving the old block untouched if one of the sizes is under the
+    /// threshold or the kernel refused; the caller then has to copy
+    ///
+    auto reallocate(T* block, std::size_t old_count, std::size_t new_count) noexcept -> T*
+    {
+        if (new_count > (static_cast<std::size_t>(-1) - page_size) / sizeof(T))
+            return nullptr;
+
+        const std::size_t old_bytes{ old_count * sizeof(T) };
+        const std::size_t new_bytes{ new_count * sizeof(T) };
+
+        if (not is_mapped(old_bytes) or not is_mapped(new_bytes))
+            return nullptr;
+
+#if defined(__linux__)
+        void* const mapping{ ::mremap(static_cast<void*>(block), mapping_size(old_bytes), mapping_size(new_bytes),
+            MREMAP_MAYMOVE) };
+
+        return mapping == MAP_FAILED ? nullptr : static_cast<T*>(mapping);
+#else
+        (void)block;
+        return nullptr;
+#endif
+    }
+
+private:
+    static constexpr auto is_mapped(std::size_t bytes) noexcept -> bool
+    {
+        return bytes != 0 and bytes >= Threshold;
+    }
+
+    static constexpr auto mapping_size(std::size_t bytes) noexcept -> std::size_t
+    {
+        return detail::round_up(bytes, page_size);
+    }
+};
+
+template <typename T, typename U, std::size_t N, std::size_t M>
+auto operator==(const mremap_allocator<T, N>&, const mremap_allocator<U, M>&) noexcept -> bool
+{
+    return N == M;
+}
+
+template <typename T, typename U, std::size_t N, std::size_t M>
+auto operator!=(const mremap_allocator<T, N>&, const mremap_allocator<U, M>&) noexcept -> bool
+{
+    return N != M;
+}
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,595 @@
+#ifndef PARALLEL_HH
+#define PARALLEL_HH
+
+// C++ standard library includes
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include "vector.h"
+
+///
+/// Data parallel algorithms over kt::vector: for_each, transform, reduce,
+/// sort and inclusive_scan. The elements are split into chunks of "grain"
+/// elements (64 KiB worth by default) which run on a work-stealing thread
+/// pool. Ranges that fit in a single chunk are processed serially on the
+/// calling thread, which also works through chunks while it waits.
+///
+/// Every algorithm takes the grain and the pool as optional trailing
+/// arguments. The functions passed in are called concurrently and must not
+/// touch elements outside the one they are given. reduce and inclusive_scan
+/// regroup the operations, so the operation must be associative
+///
+namespace kt::parallel
+{
+class thread_pool;
+
+namespace detail
+{
+    struct worker_identity
+    {
+        const thread_pool* pool;
+        std::size_t index;
+    };
+
+    // lets submissions from inside a task go to the deque of the worker running it
+    inline thread_local worker_identity current_worker{ nullptr, 0 };
+}
+
+///
+/// Fixed set of worker threads with one task deque each. A worker runs the
+/// newest task of its own deque first, which keeps recursively split work
+/// hot in its cache, and steals the oldest task of another deque once its
+/// own is empty. Tasks submitted from other threads are spread round robin
+///
+class thread_pool
+{
+public:
+    using task = std::function<void()>;
+
+    ///
+    /// One worker less than the hardware threads, the thread waiting
+    /// for the results works through tasks as well
+    ///
+    static auto default_thread_count() -> std::size_t
+    {
+        const std::size_t hardware{ std::thread::hardware_concurrency() };
+        return hardware > 2 ? hardware - 1 : 1;
+    }
+
+    explicit thread_pool(std::size_t thread_count = default_thread_count())
+        :   m_queues{ std::make_unique<queue[]>(thread_count ? thread_count : 1) }
+        ,   m_queue_count{ thread_count ? thread_count : 1 }
+    {
+        this->m_threads.reserve(thread_count);
+
+        for (std::size_t index{}; index < thread_count; ++index)
+            this->m_threads.emplace_back([this, index]() -> void { this->worker_loop(index); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ///
+    /// Runs whatever is still queued, then joins the workers
+    ///
+    ~thread_pool()
+    {
+        {
+            const std::lock_guard<std::mutex> guard{ this->m_sleep_lock };
+            this->m_stopping = true;
+        }
+
+        this->m_wake.notify_all();
+
+        for (std::thread& worker : this->m_threads)
+            worker.join();
+    }
+
+    auto thread_count() const -> std::size_t
+    {
+        return this->m_threads.size();
+    }
+
+    ///
+    /// Queues "work" to run on a worker, or on a thread waiting in task_group::wait()
+    ///
+    auto submit(task work) -> void
+    {
+        const std::size_t target{ detail::current_worker.pool == this
+            ? detail::current_worker.index
+            : this->m_next_queue.fetch_add(1, std::memory_order_relaxed) % this->m_queue_count };
+
+        {
+            const std::lock_guard<std::mutex> guard{ this->m_queues[target].lock };
+            this->m_queues[target].tasks.push_back(std::move(work));
+        }
+
+        this->m_pending.fetch_add(1, std::memory_order_release);
+
+        // taking the lock orders this notification after a worker's last look at m_pending
+        {
+            const std::lock_guard<std::mutex> guard{ this->m_sleep_lock };
+        }
+
+        this->m_wake.notify_one();
+    }
+
+    ///
+    /// Runs one queued task on the calling thread. Returns false if there was none
+    ///
+    auto run_pending_task() -> bool
+    {
+        task work{ this->take(detail::current_worker.pool == this ? detail::current_worker.index : this->m_queue_count) };
+
+        if (not work)
+            return false;
+
+        work();
+
+        return true;
+    }
+
+private:
+    struct queue
+    {
+        std::mutex lock;
+        std::deque<task> tasks;
+    };
+
+    // newest task of deque "home" if there is one, otherwise the oldest of any other
+    auto take(std::size_t home) -> task
+    {
+        task work{};
+
+        if (home < this->m_queue_count)
+        {
+            const std::lock_guard<std::mutex> guard{ this->m_queues[home].lock };
+
+            if (not this->m_queues[home].tasks.empty())
+            {
+                work = std::move(this->m_queues[home].tasks.back());
+                this->m_queues[home].tasks.pop_back();
+            }
+        }
+
+        for (std::size_t offset{ 1 }; not work and offset <= this->m_queue_count; ++offset)
+        {
+            queue& victim{ this->m_queues[(home + offset) % this->m_queue_count] };
+            const std::lock_guard<std::mutex> guard{ victim.lock };
+
+            if (not victim.tasks.empty())
+            {
+                work = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+
+        if (work)
+            this->m_pending.fetch_sub(1, std::memory_order_relaxed);
+
+        return work;
+    }
+
+    auto worker_loop(std::size_t index) -> void
+    {
+        detail::current_worker = { this, index };
+
+        for (;;)
+        {
+            if (task work{ this->take(index) })
+            {
+                work();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> guard{ this->m_sleep_lock };
+
+            this->m_wake.wait(guard, [this]() -> bool
+            {
+                return this->m_stopping or this->m_pending.load(std::memory_order_acquire) != 0;
+            });
+
+            if (this->m_stopping and this->m_pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    std::unique_ptr<queue[]> m_queues;
+    std::size_t m_queue_count;
+    std::vector<std::thread> m_threads{};
+    std::atomic<std::size_t> m_pending{};
+    std::atomic<std::size_t> m_next_queue{};
+    std::mutex m_sleep_lock{};
+    std::condition_variable m_wake{};
+    bool m_stopping{};
+};
+
+///
+/// Pool shared by every algorithm that is not given one explicitly
+///
+inline auto default_pool() -> thread_pool&
+{
+    static thread_pool instance{};
+    return instance;
+}
+
+///
+/// Tasks that can be waited for together. wait() runs queued tasks of the
+/// pool on the calling thread until every task of the group has finished,
+/// so tasks may themselves run groups without starving the pool. The first
+/// exception thrown by a task is rethrown by wait()
+///
+class task_group
+{
+public:
+    explicit task_group(thread_pool& pool = default_pool())
+        :   m_pool{ pool }
+    {
+
+    }
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    // tasks still reference the group, never leave before they are done
+    ~task_group()
+    {
+        this->join();
+    }
+
+    template <typename Function>
+    auto run(Function&& function) -> void
+    {
+        this->m_remaining.fetch_add(1, std::memory_order_relaxed);
+
+        this->m_pool.submit([this, function = std::forward<Function>(function)]() mutable -> void
+        {
+            try
+            {
+                function();
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> guard{ this->m_error_lock };
+
+                if (not this->m_error)
+                    this->m_error = std::current_exception();
+            }
+
+            this->m_remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    auto wait() -> void
+    {
+        this->join();
+
+        if (this->m_error)
+            std::rethrow_exception(std::exchange(this->m_error, nullptr));
+    }
+
+private:
+    auto join() -> void
+    {
+        while (this->m_remaining.load(std::memory_order_acquire) != 0)
+            if (not this->m_pool.run_pending_task())
+                std::this_thread::yield();
+    }
+
+    thread_pool& m_pool;
+    std::atomic<std::size_t> m_remaining{};
+    std::mutex m_error_lock{};
+    std::exception_ptr m_error{};
+};
+
+///
+/// Bytes of elements per chunk when no grain is given
+///
+inline constexpr std::size_t chunk_bytes{ 64 * 1024 };
+
+template <typename T>
+constexpr auto default_grain() -> std::size_t
+{
+    return chunk_bytes / sizeof(T) ? chunk_bytes / sizeof(T) : 1;
+}
+
+namespace detail
+{
+    inline auto chunk_count(std::size_t count, std::size_t grain) -> std::size_t
+    {
+        return (count + grain - 1) / grain;
+    }
+
+    // call body(chunk index, first index, end index) for every chunk of "grain" elements
+    template <typename Body>
+    auto for_each_chunk(std::size_t count, std::size_t grain, thread_pool& pool, const Body& body) -> void
+    {
+        const std::size_t chunks{ chunk_count(count, grain) };
+
+        if (chunks <= 1)
+        {
+            if (count != 0)
+                body(std::size_t{}, std::size_t{}, count);
+
+            return;
+        }
+
+        task_group group{ pool };
+
+        for (std::size_t chunk{ 1 }; chunk < chunks; ++chunk)
+            group.run([&body, chunk, count, grain]() -> void
+            {
+                body(chunk, chunk * grain, std::min(count, (chunk + 1) * grain));
+            });
+
+        body(std::size_t{}, std::size_t{}, grain);
+        group.wait();
+    }
+
+    // quicksort splitting around a median of three, the part below the pivot
+    // becomes a new task while this one carries on with the part above it
+    template <typename T, typename Compare>
+    auto sort_range(T* first, T* last, const Compare& compare, std::size_t grain, task_group& group) -> void
+    {
+        while (static_cast<std::size_t>(last - first) > grain)
+        {
+            T* middle{ first + (last - first) / 2 };
+            T* back{ last - 1 };
+
+            // move the median of the first, middle and last elements to the front
+            if (compare(*middle, *first))
+                std::iter_swap(middle, first);
+            if (compare(*back, *middle))
+            {
+                std::iter_swap(back, middle);
+
+                if (compare(*middle, *first))
+                    std::iter_swap(middle, first);
+            }
+
+            std::iter_swap(first, middle);
+
+            // [first + 1, less_end) < pivot <= [less_end, equal_end) < [equal_end, last)
+            T* less_end{ std::partition(first + 1, last, [first, &compare](const T& value) -> bool
+            {
+                return compare(value, *first);
+            }) };
+
+            T* equal_end{ std::partition(less_end, last, [first, &compare](const T& value) -> bool
+            {
+                return not compare(*first, value);
+            }) };
+
+            std::iter_swap(first, less_end - 1);
+
+            T* less_first{ first };
+            T* less_last{ less_end - 1 };
+
+            if (less_last - less_first > 1)
+                group.run([less_first, less_last, &compare, grain, &group]() -> void
+                {
+                    sort_range(less_first, less_last, compare, grain, group);
+                });
+
+            first = equal_end;
+        }
+
+        std::sort(first, last, compare);
+    }
+}
+
+///
+/// Calls "function" on every element
+///
+template <typename T, typename Alloc, typename Growth, typename Errors, typename Function>
+auto for_each(vector<T, Alloc, Growth, Errors>& values, Function function,
+    std::size_t grain = default_grain<T>(), thread_pool& pool = default_pool()) -> void
+{
+    T* const data{ values.data() };
+
+    detail::for_each_chunk(values.size(), grain ? grain : 1, pool,
+        [data, &function](std::size_t, std::size_t first, std::size_t last) -> void
+        {
+            for (std::size_t index{ first }; index < last; ++index)
+                function(data[index]);
+        });
+}
+
+template <typename T, typename Alloc, typename Growth, typename Errors, typename Function>
+auto for_each(const vector<T, Alloc, Growth, Errors>& values, Function function,
+    std::size_t grain = default_grain<T>(), thread_pool& pool = default_pool()) -> void
+{
+    const T* const data{ values.data() };
+
+    detail::for_each_chunk(values.size(), grain ? grain : 1, pool,
+        [data, &function](std::size_t, std::size_t first, std::size_t last) -> void
+        {
+            for (std::size_t index{ first }; index < last; ++index)
+                function(data[index]);
+        });
+}
+
+///
+/// output[i] = operation(input[i]). "output" is resized to the size of
+/// "input" first and may be the same vector as "input"
+///
+template <typename T, typename AllocIn, typename GrowthIn, typename ErrorsIn,
+    typename U, typename AllocOut, typename GrowthOut, typename ErrorsOut, typename Operation>
+auto transform(const vector<T, AllocIn, GrowthIn, ErrorsIn>& input, vector<U, AllocOut, GrowthOut, ErrorsOut>& output,
+    Operation operation, std::size_t grain = default_grain<T>(), thread_pool& pool = default_pool()) -> void
+{
+    if (output.size() != input.size())
+        output.resize(input.size());
+
+    const T* const source{ input.data() };
+    U* const dest{ output.data() };
+
+    detail::for_each_chunk(input.size(), grain ? grain : 1, pool,
+        [source, dest, &operation](std::size_t, std::size_t first, std::size_t last) -> void
+        {
+            for (std::size_t index{ first }; index < last; ++index)
+                dest[index] = operation(source[index]);
+        });
+}
+
+///
+/// "init" combined with every element through "operation", which has to be
+/// associative. Each chunk is folded on its own, then the chunk results are
+/// folded in order
+///
+template <typename T, typename Alloc, typename Growth, typename Errors, typename Operation = std::plus<>>
+auto reduce(const vector<T, Alloc, Growth, Errors>& values, T init, Operation operation = {},
+    std::size_t grain = default_grain<T>(), thread_pool& pool = default_pool()) -> T
+{
+    grain = grain ? grain : 1;
+
+    const T* const data{ values.data() };
+    const std::size_t chunks{ detail::chunk_count(values.size(), grain) };
+
+    if (chunks <= 1)
+    {
+        for (std::size_t index{}; index < values.size(); ++index)
+            init = operation(std::move(init), data[index]);
+
+        return init;
+    }
+
+    vector<T> partials{};
+    partials.resize(chunks, init);
+
+    detail::for_each_chunk(values.size(), grain, pool,
+        [data, &partials, &operation](std::size_t chunk, std::size_t first, std::size_t last) -> void
+        {
+            T partial{ data[first] };
+
+            for (std::size_t index{ first + 1 }; index < last; ++index)
+                partial = operation(std::move(partial), data[index]);
+
+            partials[chunk] = std::move(partial);
+        });
+
+    for (std::size_t chunk{}; chunk < chunks; ++chunk)
+        init = operation(std::move(init), partials[chunk]);
+
+    return init;
+}
+
+///
+/// Sorts the elements by "compare". Not stable
+///
+template <typename T, typename Alloc, typename Growth, typename Errors, typename Compare = std::less<>>
+auto sort(vector<T, Alloc, Growth, Errors>& values, Compare compare = {},
+    std::size_t grain = default_grain<T>(), thread_pool& pool = default_pool()) -> void
+{
+    grain = grain > 2 ? grain : 2;
+
+    if (values.size() <= grain)
+    {
+        std::sort(values.data(), values.data() + values.size(), compare);
+        return;
+    }
+
+    task_group group{ pool };
+    detail::sort_range(values.data(), values.data() + values.size(), compare, grain, group);
+    group.wait();
+}
+
+///
+/// output[i] = input[0] op input[1] op ... op input[i]. "output" is resized to
+/// the size of "input" first and may be the same vector as "input". Runs in
+/// three passes: fold every chunk, scan the chunk totals serially, then scan
+/// every chunk again starting from the total of the chunks before it
+///
+template <typename T, typename AllocIn, typename GrowthIn, typename ErrorsIn,
+    typename AllocOut, typename GrowthOut, typename ErrorsOut, typename Operation = std::plus<>>
+auto inclusive_scan(const vector<T, AllocIn, GrowthIn, ErrorsIn>& input, vector<T, AllocOut, GrowthOut, ErrorsOut>& output,
+    Operation operation = {}, std::size_t grain = default_grain<T>(), thread_pool& pool = default_pool()) -> void
+{
+    grain = grain ? grain : 1;
+
+    const std::size_t count{ input.size() };
+
+    if (output.size() != count)
+        output.resize(count);
+
+    const T* const source{ input.data() };
+    T* const dest{ output.data() };
+
+    const auto scan_chunk{ [source, dest, &operation](std::size_t first, std::size_t last, T carry) -> void
+    {
+        for (std::size_t index{ first }; index < last; ++index)
+        {
+            carry = operation(std::move(carry), source[index]);
+            dest[index] = carry;
+        }
+    } };
+
+    const std::size_t chunks{ detail::chunk_count(count, grain) };
+
+    if (chunks <= 1)
+    {
+        if (count != 0)
+        {
+            dest[0] = source[0];
+            scan_chunk(1, count, source[0]);
+        }
+
+        return;
+    }
+
+    vector<T> totals{};
+    totals.resize(chunks - 1, source[0]);
+
+    // the total of the last chunk is never needed
+    detail::for_each_chunk((chunks - 1) * grain, grain, pool,
+        [source, &totals, &operation](std::size_t chunk, std::size_t first, std::size_t last) -> void
+        {
+            T total{ source[first] };
+
+            for (std::size_t index{ first + 1 }; index < last; ++index)
+                total = operation(std::move(total), source[index]);
+
+            totals[chunk] = std::move(total);
+        });
+
+    for (std::size_t chunk{ 1 }; chunk < totals.size(); ++chunk)
+        totals[chunk] = operation(totals[chunk - 1], totals[chunk]);
+
+    detail::for_each_chunk(count, grain, pool,
+        [source, dest, &totals, &scan_chunk](std::size_t chunk, std::size_t first, std::size_t last) -> void
+        {
+            if (chunk == 0)
+            {
+                dest[0] = source[0];
+                scan_chunk(1, last, source[0]);
+            }
+            else
+                scan_chunk(first, last, totals[chunk - 1]);
+        });
+}
+
+///
+/// In place inclusive_scan
+///
+template <typename T, typename Alloc, typename Growth, typename Errors, typename Operation = std::plus<>,
+    typename = std::enable_if_t<std::is_invocable_v<Operation&, T, const T&>>>
+auto inclusive_scan(vector<T, Alloc, Growth, Errors>& values, Operation operation = {},
+    std::size_t grain = default_grain<T>(), thread_pool& pool = default_pool()) -> void
+{
+    parallel::inclusive_scan(values, values, std::move(operation), grain, pool);
+}
+
+}   // END KT::PARALLEL NAMESPACE
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef POOL_ALLOCATOR_HH
+#define POOL_ALLOCATOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace kt
+{
+///
+/// Pool of fixed size classes. Requests up to "max_class_size" bytes are
+/// rounded up to the next power of two and served from a per-class free
+/// list carved out of big slabs. Larger requests go to the global heap but
+/// are still tracked, so reset() gives back everything the pool handed out
+///
+class pool
+{
+public:
+    static constexpr std::size_t min_class_size{ 16 };
+    static constexpr std::size_t max_class_size{ 4096 };
+    static constexpr std::size_t class_count{ 9 };          // 16, 32, ..., 4096
+    static constexpr std::size_t default_slab_size{ 64 * 1024 };
+
+    ///
+    /// Creates an empty pool. No memory is requested until the first allocation
+    ///
+    explicit pool(std::size_t slab_size = default_slab_size)
+        :   m_free_lists{}, m_slabs{ nullptr }, m_large{ nullptr },
+            m_slab_size{ slab_size < max_class_size ? max_class_size : slab_size }
+    {
+
+    }
+
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+
+    ///
+    /// Destructor. Returns every slab and large block to the global heap
+    ///
+    ~pool()
+    {
+        reset();
+    }
+
+    ///
+    /// Returns a block of at least "bytes" bytes aligned to "alignment".
+    /// Throws std::bad_alloc if the heap could not provide more memory
+    ///
+    auto allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) -> void*
+    {
+        if (bytes > max_class_size or alignment > min_class_size)
+            return allocate_large(bytes, alignment);
+
+        const std::size_t index{ class_index(bytes) };
+
+        if (not this->m_free_lists[index])
+            refill(index);
+
+        free_node* node{ this->m_free_lists[index] };
+        this->m_free_lists[index] = node->next;
+
+        return static_cast<void*>(node);
+    }
+
+    ///
+    /// Gives back a block obtained from allocate(). "bytes" and "alignment"
+    /// must be the same values used for the allocation
+    ///
+    auto deallocate(void* block, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept -> void
+    {
+        if (not block)
+            return;
+
+        if (bytes > max_class_size or alignment > min_class_size)
+        {
+            deallocate_large(block);
+            return;
+        }
+
+        const std::size_t index{ class_index(bytes) };
+
+        auto node{ static_cast<free_node*>(block) };
+        node->next = this->m_free_lists[index];
+        this->m_free_lists[index] = node;
+    }
+
+    ///
+    /// Invalidates every block handed out so far and gives all the memory back
+    ///
+    auto reset() noexcept -> void
+    {
+        while (this->m_slabs)
+        {
+            slab_header* next{ this->m_slabs->next };
+            ::operator delete(static_cast<void*>(this->m_slabs));
+            this->m_slabs = next;
+        }
+
+        while (this->m_large)
+        {
+            large_header* next{ this->m_large->next };
+            ::operator delete(static_cast<void*>(this->m_large), std::align_val_t{ this->m_large->alignment });
+            this->m_large = next;
+        }
+
+        for (auto& list : this->m_free_lists)
+            list = nullptr;
+    }
+
+private:
+    struct free_node
+    {
+        free_node* next;
+    };
+
+    struct slab_header
+    {
+        slab_header* next;
+        std::size_t padding;
+    };
+
+    // large blocks live in a doubly linked list so they can be unlinked in O(1)
+    struct large_header
+    {
+        large_header* next;
+        large_header* prev;
+        std::size_t alignment;
+        std::size_t offset;
+    };
+
+    static auto class_index(std::size_t bytes) noexcept -> std::size_t
+    {
+        std::size_t index{};
+        std::size_t class_size{ min_class_size };
+
+        while (class_size < bytes)
+        {
+            class_size <<= 1;
+            ++index;
+        }
+
+        return index;
+    }
+
+    auto refill(std::size_t index) -> void
+    {
+        const std::size_t class_size{ min_class_size << index };
+
+        auto slab{ static_cast<slab_header*>(::operator new(sizeof(slab_header) + this->m_slab_size)) };
+        slab->next = this->m_slabs;
+        this->m_slabs = slab;
+
+        // thread every block of the slab into the free list of this class
+        auto first{ reinterpret_cast<std::byte*>(slab + 1) };
+        const std::size_t block_count{ this->m_slab_size / class_size };
+
+        for (std::size_t block{ block_count }; block != 0; --block)
+        {
+            auto node{ reinterpret_cast<free_node*>(first + (block - 1) * class_size) };
+            node->next = this->m_free_lists[index];
+            this->m_free_lists[index] = node;
+        }
+    }
+
+    auto allocate_large(std::size_t bytes, std::size_t alignment) -> void*
+    {
+        if (alignment < alignof(large_header))
+            alignment = alignof(large_header);
+
+        // the header sits right before the user block, padded to keep the block aligned
+        const std::size_t offset{ (sizeof(large_header) + alignment - 1) & ~(alignment - 1) };
+
+        auto raw{ static_cast<std::byte*>(::operator new(offset + bytes, std::align_val_t{ alignment })) };
+        auto header{ reinterpret_cast<large_header*>(raw + offset - sizeof(large_header)) };
+
+        header->alignment = alignment;
+        header->offset = offset;
+        header->prev = nullptr;
+        header->next = this->m_large;
+
+        if (this->m_large)
+            this->m_large->prev = header;
+
+        this->m_large = header;
+
+        return static_cast<void*>(raw + offset);
+    }
+
+    auto deallocate_large(void* block) noexcept -> void
+    {
+        auto header{ reinterpret_cast<large_header*>(static_cast<std::byte*>(block) - sizeof(large_header)) };
+
+        if (header->prev)
+            header->prev->next = header->next;
+        else
+            this->m_large = header->next;
+
+        if (header->next)
+            header->next->prev = header->prev;
+
+        ::operator delete(static_cast<void*>(static_cast<std::byte*>(block) - header->offset),
+            std::align_val_t{ header->alignment });
+    }
+
+    free_node* m_free_lists[class_count];
+    slab_header* m_slabs;
+    large_header* m_large;
+    std::size_t m_slab_size;
+};
+
+///
+/// Standard allocator adaptor over kt::pool
+///
+template <typename T>
+class pool_allocator
+{
+public:
+    using value_type = T;
+
+    // copies stay in the pool of the source container, moves and swaps carry the pool along
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    explicit pool_allocator(pool& source) noexcept
+        :   m_pool{ &source }
+    {
+
+    }
+
+    template <typename U>
+    pool_allocator(const pool_allocator<U>& other) noexcept
+        :   m_pool{ other.resource() }
+    {
+
+    }
+
+    auto allocate(std::size_t count) -> T*
+    {
+        return static_cast<T*>(this->m_pool->allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    auto deallocate(T* block, std::size_t count) noexcept -> void
+    {
+        this->m_pool->deallocate(static_cast<void*>(block), sizeof(T) * count, alignof(T));
+    }
+
+    auto resource() const noexcept -> pool*
+    {
+        return this->m_pool;
+    }
+
+private:
+    pool* m_pool;
+};
+
+template <typename T, typename U>
+auto operator==(const pool_allocator<T>& lhs, const pool_allocator<U>& rhs) noexcept -> bool
+{
+    return lhs.resource() == rhs.resource();
+}
+
+template <typename T, typename U>
+auto operator!=(const pool_allocator<T>& lhs, const pool_allocator<U>& rhs) noexcept -> bool
+{
+    return not (lhs == rhs);
+}
+
+}   // END KT NAMESPACE
+
+#endif
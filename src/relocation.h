@@ -0,0 +1,180 @@
+#ifndef RELOCATION_HH
+#define RELOCATION_HH
+
+// C++ standard library includes
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+namespace kt
+{
+///
+/// A type is trivially relocatable if moving an object to a new address and
+/// ending the lifetime of the old one is equivalent to copying its bytes.
+/// Every trivially copyable type is, and types such as string handles or
+/// owning pointers can opt in by specializing this trait
+///
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> { };
+
+// an owning pointer with the default deleter is just a pointer once moved
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type { };
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v{ is_trivially_relocatable<T>::value };
+
+///
+/// Copy "count" elements starting at "source" into the uninitialized block
+/// "dest". If one of the copies throws, the elements already constructed are
+/// destroyed and the exception is propagated
+///
+template <typename T, typename Alloc>
+auto uninitialized_copy_n(Alloc& alloc, const T* source, std::size_t count, T* dest) -> void
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (count != 0)
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(source), count * sizeof(T));
+    }
+    else
+    {
+        using alloc_traits = std::allocator_traits<Alloc>;
+        std::size_t index{};
+
+        try
+        {
+            for (; index < count; ++index)
+                alloc_traits::construct(alloc, dest + index, source[index]);
+        }
+        catch (...)
+        {
+            for (std::size_t done{}; done < index; ++done)
+                alloc_traits::destroy(alloc, dest + done);
+
+            throw;
+        }
+    }
+}
+
+///
+/// Move "count" elements from "source" into the uninitialized block "dest",
+/// which must not overlap with the source. On return the source elements
+/// are destroyed. Types whose move constructor may throw are copied instead
+/// and the source is left untouched if one of the copies fails
+///
+template <typename T, typename Alloc>
+auto relocate_n(Alloc& alloc, T* source, std::size_t count, T* dest) -> void
+{
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (count != 0)
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(source), count * sizeof(T));
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T> or not std::is_copy_constructible_v<T>)
+    {
+        for (std::size_t index{}; index < count; ++index)
+        {
+            alloc_traits::construct(alloc, dest + index, std::move(source[index]));
+            alloc_traits::destroy(alloc, source + index);
+        }
+    }
+    else
+    {
+        uninitialized_copy_n(alloc, static_cast<const T*>(source), count, dest);
+
+        for (std::size_t index{}; index < count; ++index)
+            alloc_traits::destroy(alloc, source + index);
+    }
+}
+
+///
+/// Same as relocate_n() but "source" and "dest" may overlap,
+/// as happens when shifting elements within one block
+///
+template <typename T, typename Alloc>
+auto relocate_overlapping(Alloc& alloc, T* source, std::size_t count, T* dest) noexcept -> void
+{
+    static_assert(is_trivially_relocatable_v<T> or std::is_nothrow_move_constructible_v<T>,
+        "shifting elements in place requires a non-throwing move constructor");
+
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (count != 0)
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(source), count * sizeof(T));
+    }
+    else
+    {
+        // every source slot is destroyed right after being moved from, so walking in
+        // the right direction means the next destination slot is always uninitialized
+        if (dest < source)
+        {
+            for (std::size_t index{}; index < count; ++index)
+            {
+                alloc_traits::construct(alloc, dest + index, std::move(source[index]));
+                alloc_traits::destroy(alloc, source + index);
+            }
+        }
+        else if (dest > source)
+        {
+            for (std::size_t index{ count }; index != 0; --index)
+            {
+                alloc_traits::construct(alloc, dest + index - 1, std::move(source[index - 1]));
+                alloc_traits::destroy(alloc, source + index - 1);
+            }
+        }
+    }
+}
+
+///
+/// Destroy "count" elements starting at "first". No-op for trivially destructible types
+///
+template <typename T, typename Alloc>
+auto destroy_n(Alloc& alloc, T* first, std::size_t count) noexcept -> void
+{
+    if constexpr (not std::is_trivially_destructible_v<T>)
+    {
+        for (std::size_t index{}; index < count; ++index)
+            std::allocator_traits<Alloc>::destroy(alloc, first + index);
+    }
+}
+
+///
+/// An allocator can resize its blocks without the container copying the
+/// elements if it has a member reallocate(block, old_count, new_count)
+/// returning the block at its new address, or nullptr when it cannot.
+/// The bytes are moved as they are, only valid for trivially relocatable types
+///
+template <typename Alloc, typename = void>
+struct can_reallocate_in_place : std::false_type { };
+
+template <typename Alloc>
+struct can_reallocate_in_place<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+    std::declval<typename std::allocator_traits<Alloc>::pointer>(), std::size_t{}, std::size_t{}))>> : std::true_type { };
+
+template <typename Alloc>
+inline constexpr bool can_reallocate_in_place_v{ can_reallocate_in_place<Alloc>::value };
+
+///
+/// An allocator reports the real size of its blocks if it has a member
+/// allocate_at_least(count) returning the block and the amount of elements
+/// it holds, like C++23's std::allocator_traits::allocate_at_least
+///
+template <typename Alloc, typename = void>
+struct allocates_at_least : std::false_type { };
+
+template <typename Alloc>
+struct allocates_at_least<Alloc, std::void_t<decltype(std::declval<Alloc&>().allocate_at_least(std::size_t{}))>> : std::true_type { };
+
+template <typename Alloc>
+inline constexpr bool allocates_at_least_v{ allocates_at_least<Alloc>::value };
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef SEGMENT_MATH_HH
+#define SEGMENT_MATH_HH
+
+// C++ standard library includes
+#include <cstddef>
+#include <utility>
+
+#include "growth_policy.h"
+
+namespace kt
+{
+namespace detail
+{
+    ///
+    /// Layout shared by the segmented containers: segment 0 holds
+    /// first_segment_size elements and every following segment twice as
+    /// many as the one before, so an index is turned into a segment and an
+    /// offset with a single count-leading-zeros
+    ///
+    template <typename T>
+    struct segment_math
+    {
+        using size_type = std::size_t;
+
+        ///
+        /// Elements in segment 0, the smallest power of two covering a cache line worth of them
+        ///
+        static constexpr size_type first_segment_size{ []() -> size_type
+        {
+            size_type size{ 1 };
+
+            while (size < initial_capacity(sizeof(T)) or size < 8)
+                size *= 2;
+
+            return size;
+        }() };
+
+        static constexpr size_type first_segment_bits{ []() -> size_type
+        {
+            size_type bits{};
+
+            while ((size_type{ 1 } << bits) < first_segment_size)
+                ++bits;
+
+            return bits;
+        }() };
+
+        ///
+        /// Segments needed to address every index a size_type can hold
+        ///
+        static constexpr size_type max_segments{ 64 - first_segment_bits };
+
+        static constexpr auto segment_size(size_type segment) -> size_type
+        {
+            return first_segment_size << segment;
+        }
+
+        // index + first_segment_size has its highest bit at first_segment_bits + segment
+        static auto locate(size_type index) -> std::pair<size_type, size_type>
+        {
+            const size_type biased{ index + first_segment_size };
+            const size_type high_bit{ 63 - static_cast<size_type>(__builtin_clzll(biased)) };
+
+            return { high_bit - first_segment_bits, biased - (size_type{ 1 } << high_bit) };
+        }
+    };
+}   // END KT::DETAIL NAMESPACE
+
+}   // END KT NAMESPACE
+
+#endif
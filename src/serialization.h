@@ -0,0 +1,444 @@
+#ifndef SERIALIZATION_HH
+#define SERIALIZATION_HH
+
+// C++ standard library includes
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+// POSIX includes
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+#include "vector.h"
+
+///
+/// Binary format for kt::vector of trivially copyable elements:
+///
+///     offset  size  field
+///          0     8  magic "KTVECTOR"
+///          8     4  format version
+///         12     4  byte order mark 0x01020304, as stored by the writer
+///         16     4  element size in bytes
+///         20     4  CRC-32C of the elements
+///         24     8  element count
+///         32        the elements, exactly as they are laid out in memory
+///
+/// Every field is stored in the byte order of the writer. A reader with the
+/// other byte order detects it through the mark and swaps the header fields
+/// and, for arithmetic element types, the elements.
+///
+/// Writing sends the elements in one bulk write after a checksum pass over
+/// them. Reading reserves the vector once and streams the elements into it
+/// in chunks, checking the checksum as it goes, so no intermediate buffer of
+/// the size of the vector is ever needed
+///
+namespace kt
+{
+enum class io_status
+{
+    ok,
+    io_error,
+    truncated,
+    bad_magic,
+    unsupported_version,
+    element_size_mismatch,
+    unsupported_byte_order,
+    checksum_mismatch,
+    out_of_memory
+};
+
+inline auto to_string(io_status status) -> const char*
+{
+    switch (status)
+    {
+        case io_status::ok:                     return "ok";
+        case io_status::io_error:               return "I/O error";
+        case io_status::truncated:              return "input ended before the last element";
+        case io_status::bad_magic:              return "not a serialized kt::vector";
+        case io_status::unsupported_version:    return "unsupported format version";
+        case io_status::element_size_mismatch:  return "stored element size does not match";
+        case io_status::unsupported_byte_order: return "elements stored in the other byte order cannot be swapped";
+        case io_status::checksum_mismatch:      return "checksum mismatch";
+        case io_status::out_of_memory:          return "could not allocate the elements";
+    }
+
+    return "unknown status";
+}
+
+namespace serialization
+{
+    inline constexpr std::uint32_t format_version{ 1 };
+    inline constexpr std::uint32_t byte_order_mark{ 0x01020304 };
+
+    // elements are read and checked this many bytes at a time
+    inline constexpr std::size_t chunk_bytes{ 8 * 1024 * 1024 };
+
+    struct file_header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t element_size;
+        std::uint32_t checksum;
+        std::uint64_t count;
+    };
+
+    static_assert(sizeof(file_header) == 32, "the header layout is part of the format");
+
+    namespace detail
+    {
+        inline constexpr char magic[8]{ 'K', 'T', 'V', 'E', 'C', 'T', 'O', 'R' };
+
+        // CRC-32C (Castagnoli), reflected polynomial
+        inline constexpr std::array<std::uint32_t, 256> crc32c_table{ []() -> std::array<std::uint32_t, 256>
+        {
+            std::array<std::uint32_t, 256> table{};
+
+            for (std::uint32_t byte{}; byte < 256; ++byte)
+            {
+                std::uint32_t crc{ byte };
+
+                for (int bit{}; bit < 8; ++bit)
+                    crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+
+                table[byte] = crc;
+            }
+
+            return table;
+        }() };
+
+        inline auto crc32c_portable(std::uint32_t crc, const unsigned char* data, std::size_t size) -> std::uint32_t
+        {
+            for (std::size_t index{}; index < size; ++index)
+                crc = crc32c_table[(crc ^ data[index]) & 0xFF] ^ (crc >> 8);
+
+            return crc;
+        }
+
+#if defined(__x86_64__)
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+        // the crc32 instruction of SSE 4.2 implements the same polynomial
+        inline auto crc32c_sse42(std::uint32_t crc, const unsigned char* data, std::size_t size) -> std::uint32_t
+        {
+            std::uint64_t wide{ crc };
+            std::size_t index{};
+
+            for (; index + 8 <= size; index += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data + index, 8);
+                wide = _mm_crc32_u64(wide, word);
+            }
+
+            crc = static_cast<std::uint32_t>(wide);
+
+            for (; index < size; ++index)
+                crc = _mm_crc32_u8(crc, data[index]);
+
+            return crc;
+        }
+#pragma GCC pop_options
+#endif
+
+        ///
+        /// Continue the CRC-32C "crc" over "size" more bytes. Start with 0
+        ///
+        inline auto crc32c(std::uint32_t crc, const void* data, std::size_t size) -> std::uint32_t
+        {
+            const auto* const bytes{ static_cast<const unsigned char*>(data) };
+            crc = ~crc;
+
+#if defined(__x86_64__)
+            static const bool hardware{ __builtin_cpu_supports("sse4.2") != 0 };
+
+            if (hardware)
+                return ~crc32c_sse42(crc, bytes, size);
+#endif
+            return ~crc32c_portable(crc, bytes, size);
+        }
+
+        template <typename U>
+        auto byte_swap(U value) -> U
+        {
+            static_assert(sizeof(U) == 2 or sizeof(U) == 4 or sizeof(U) == 8, "unsupported size");
+
+            if constexpr (sizeof(U) == 2)
+            {
+                std::uint16_t bits;
+                std::memcpy(&bits, &value, 2);
+                bits = __builtin_bswap16(bits);
+                std::memcpy(&value, &bits, 2);
+            }
+            else if constexpr (sizeof(U) == 4)
+            {
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, 4);
+                bits = __builtin_bswap32(bits);
+                std::memcpy(&value, &bits, 4);
+            }
+            else
+            {
+                std::uint64_t bits;
+                std::memcpy(&bits, &value, 8);
+                bits = __builtin_bswap64(bits);
+                std::memcpy(&value, &bits, 8);
+            }
+
+            return value;
+        }
+
+        template <typename T>
+        inline constexpr bool can_swap_elements{ std::is_arithmetic_v<T>
+            and (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8) };
+
+        template <typename T>
+        auto make_header(const T* data, std::size_t count) -> file_header
+        {
+            file_header header{};
+
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.version = format_version;
+            header.byte_order = byte_order_mark;
+            header.element_size = sizeof(T);
+            header.checksum = crc32c(0, data, count * sizeof(T));
+            header.count = count;
+
+            return header;
+        }
+
+        ///
+        /// Validate "header" for elements of type T, swapping its fields
+        /// first if the writer used the other byte order
+        ///
+        template <typename T>
+        auto check_header(file_header& header, bool& swapped) -> io_status
+        {
+            if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+                return io_status::bad_magic;
+
+            swapped = header.byte_order != byte_order_mark;
+
+            if (swapped)
+            {
+                if (byte_swap(header.byte_order) != byte_order_mark)
+                    return io_status::bad_magic;
+
+                header.version = byte_swap(header.version);
+                header.element_size = byte_swap(header.element_size);
+                header.checksum = byte_swap(header.checksum);
+                header.count = byte_swap(header.count);
+            }
+
+            if (header.version != format_version)
+                return io_status::unsupported_version;
+
+            if (header.element_size != sizeof(T))
+                return io_status::element_size_mismatch;
+
+            if (swapped and sizeof(T) != 1 and not can_swap_elements<T>)
+                return io_status::unsupported_byte_order;
+
+            return io_status::ok;
+        }
+
+        ///
+        /// Read "count" elements described by "header" into the empty "values" through
+        /// "read_bytes(destination, bytes) -> io_status", one chunk at a time
+        ///
+        template <typename T, typename Alloc, typename Growth, typename Errors, typename ReadBytes>
+        auto read_elements(const file_header& header, bool swapped, vector<T, Alloc, Growth, Errors>& values,
+            ReadBytes&& read_bytes) -> io_status
+        {
+            const std::uint64_t count{ header.count };
+
+            if (count > static_cast<std::uint64_t>(-1) / sizeof(T))
+                return io_status::out_of_memory;
+
+            // a corrupt count must not reach the error policy of "values"
+            if (not values.try_reserve(static_cast<std::size_t>(count)))
+                return io_status::out_of_memory;
+
+            constexpr std::size_t chunk_elements{ chunk_bytes / sizeof(T) ? chunk_bytes / sizeof(T) : 1 };
+            std::uint32_t crc{};
+
+            for (std::size_t done{}; done < count;)
+            {
+                const std::size_t step{ count - done < chunk_elements ? static_cast<std::size_t>(count - done) : chunk_elements };
+
+                values.resize_default_init(done + step);
+
+                if (const io_status status{ read_bytes(values.data() + done, step * sizeof(T)) }; status != io_status::ok)
+                {
+                    values.clear();
+                    return status;
+                }
+
+                crc = crc32c(crc, values.data() + done, step * sizeof(T));
+                done += step;
+            }
+
+            if (crc != header.checksum)
+            {
+                values.clear();
+                return io_status::checksum_mismatch;
+            }
+
+            if constexpr (can_swap_elements<T> and sizeof(T) != 1)
+                if (swapped)
+                    for (std::size_t index{}; index < values.size(); ++index)
+                        values[index] = byte_swap(values[index]);
+
+            return io_status::ok;
+        }
+
+        inline auto write_all(int fd, const void* data, std::size_t size) -> io_status
+        {
+            const auto* bytes{ static_cast<const unsigned char*>(data) };
+
+            while (size != 0)
+            {
+                const ssize_t written{ ::write(fd, bytes, size) };
+
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return io_status::io_error;
+                }
+
+                bytes += written;
+                size -= static_cast<std::size_t>(written);
+            }
+
+            return io_status::ok;
+        }
+
+        inline auto read_all(int fd, void* data, std::size_t size) -> io_status
+        {
+            auto* bytes{ static_cast<unsigned char*>(data) };
+
+            while (size != 0)
+            {
+                const ssize_t received{ ::read(fd, bytes, size) };
+
+                if (received < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return io_status::io_error;
+                }
+
+                if (received == 0)
+                    return io_status::truncated;
+
+                bytes += received;
+                size -= static_cast<std::size_t>(received);
+            }
+
+            return io_status::ok;
+        }
+    }
+}
+
+///
+/// Write "values" to the file descriptor "fd" at its current offset
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto write_to(int fd, const vector<T, Alloc, Growth, Errors>& values) -> io_status
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized");
+
+    const serialization::file_header header{ serialization::detail::make_header(values.data(), values.size()) };
+
+    if (const io_status status{ serialization::detail::write_all(fd, &header, sizeof(header)) }; status != io_status::ok)
+        return status;
+
+    return serialization::detail::write_all(fd, values.data(), values.size() * sizeof(T));
+}
+
+///
+/// Replace the contents of "values" with a vector read from the file
+/// descriptor "fd". On failure "values" is left empty
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto read_from(int fd, vector<T, Alloc, Growth, Errors>& values) -> io_status
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized");
+
+    values.clear();
+
+    serialization::file_header header{};
+    bool swapped{};
+
+    if (const io_status status{ serialization::detail::read_all(fd, &header, sizeof(header)) }; status != io_status::ok)
+        return status;
+
+    if (const io_status status{ serialization::detail::check_header<T>(header, swapped) }; status != io_status::ok)
+        return status;
+
+    return serialization::detail::read_elements(header, swapped, values, [fd](void* dest, std::size_t bytes) -> io_status
+    {
+        return serialization::detail::read_all(fd, dest, bytes);
+    });
+}
+
+///
+/// Write "values" to "out", which should be opened in binary mode
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto write_to(std::ostream& out, const vector<T, Alloc, Growth, Errors>& values) -> io_status
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized");
+
+    const serialization::file_header header{ serialization::detail::make_header(values.data(), values.size()) };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+
+    return out ? io_status::ok : io_status::io_error;
+}
+
+///
+/// Replace the contents of "values" with a vector read from "in", which
+/// should be opened in binary mode. On failure "values" is left empty
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto read_from(std::istream& in, vector<T, Alloc, Growth, Errors>& values) -> io_status
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized");
+
+    values.clear();
+
+    serialization::file_header header{};
+    bool swapped{};
+
+    if (not in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return in.eof() ? io_status::truncated : io_status::io_error;
+
+    if (const io_status status{ serialization::detail::check_header<T>(header, swapped) }; status != io_status::ok)
+        return status;
+
+    return serialization::detail::read_elements(header, swapped, values, [&in](void* dest, std::size_t bytes) -> io_status
+    {
+        if (in.read(static_cast<char*>(dest), static_cast<std::streamsize>(bytes)))
+            return io_status::ok;
+
+        return in.eof() ? io_status::truncated : io_status::io_error;
+    });
+}
+
+}   // END KT NAMESPACE
+
+#endif
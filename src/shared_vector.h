@@ -0,0 +1,274 @@
+#ifndef SHARED_VECTOR_HH
+#define SHARED_VECTOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+#include "vector.h"
+#include "growth_policy.h"
+
+namespace kt
+{
+namespace detail
+{
+    ///
+    /// Block shared by the copies of one shared_vector: the elements and
+    /// the amount of shared_vectors pointing at them
+    ///
+    template <typename T, typename Alloc, typename Growth, typename Errors>
+    struct shared_block
+    {
+        explicit shared_block(vector<T, Alloc, Growth, Errors>&& source) noexcept
+            :   elements{ std::move(source) }
+        {
+
+        }
+
+        std::atomic<std::size_t> references{ 1 };
+        vector<T, Alloc, Growth, Errors> elements;
+    };
+}   // END KT::DETAIL NAMESPACE
+
+///
+/// Reference counted, copy on write snapshot of a kt::vector. Copying a
+/// shared_vector only bumps a counter, so one large table can be handed to
+/// any amount of readers without duplicating it. The elements are read
+/// through the const API; edit() gives write access and copies the
+/// elements first if other snapshots still share them, so memory is only
+/// duplicated on the first write.
+///
+/// Copies may be used and destroyed from different threads. A single
+/// shared_vector object is not synchronized, like any other container
+///
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = grow_double, typename Errors = errors_throw>
+class shared_vector
+{
+    using block_type = detail::shared_block<T, Alloc, Growth, Errors>;
+
+public:
+    using value_type            = T;
+    using vector_type           = vector<T, Alloc, Growth, Errors>;
+    using size_type             = std::size_t;
+    using const_reference_type  = const T&;
+    using const_iterator        = typename vector_type::const_iterator;
+    using iterator              = const_iterator;
+
+    ///
+    /// Default constructor. The snapshot is empty and shares nothing
+    ///
+    shared_vector() noexcept = default;
+
+    ///
+    /// Take over the block of "source" without copying its elements
+    ///
+    explicit shared_vector(vector_type&& source)
+        :   m_block{ new block_type{ std::move(source) } }
+    {
+
+    }
+
+    ///
+    /// Copy constructor. Shares the elements of "other"
+    ///
+    shared_vector(const shared_vector& other) noexcept
+        :   m_block{ other.m_block }
+    {
+        retain();
+    }
+
+    ///
+    /// Move constructor. "other" is left empty
+    ///
+    shared_vector(shared_vector&& other) noexcept
+        :   m_block{ std::exchange(other.m_block, nullptr) }
+    {
+
+    }
+
+    ///
+    /// Assigment operator. Shares the elements of "other"
+    ///
+    shared_vector& operator=(const shared_vector& other) noexcept
+    {
+        if (this->m_block != other.m_block)
+        {
+            release();
+            this->m_block = other.m_block;
+            retain();
+        }
+
+        return *this;
+    }
+
+    ///
+    /// Assigment operator with support for move semantics
+    ///
+    shared_vector& operator=(shared_vector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            this->m_block = std::exchange(other.m_block, nullptr);
+        }
+
+        return *this;
+    }
+
+    ///
+    /// Destructor. The elements are freed with the last snapshot sharing them
+    ///
+    ~shared_vector()
+    {
+        release();
+    }
+
+    ///
+    /// Amount of elements in the snapshot
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_block ? this->m_block->elements.size() : 0;
+    }
+
+    ///
+    /// Return true if the snapshot has no elements, false otherwise
+    ///
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+    ///
+    /// Amount of shared_vectors sharing these elements, 0 for an empty default constructed one
+    ///
+    auto use_count() const -> size_type
+    {
+        return this->m_block ? this->m_block->references.load(std::memory_order_acquire) : 0;
+    }
+
+    ///
+    /// Returns constant reference to element at postion "index"
+    ///
+    auto operator[](size_type index) const -> const_reference_type
+    {
+        return this->m_block->elements[index];
+    }
+
+    auto data() const -> const T*
+    {
+        return this->m_block ? this->m_block->elements.data() : nullptr;
+    }
+
+    ///
+    /// The shared elements as a read only kt::vector
+    ///
+    auto get() const -> const vector_type&
+    {
+        static const vector_type empty_elements{};
+        return this->m_block ? this->m_block->elements : empty_elements;
+    }
+
+    ///
+    /// Write access to the elements. If other snapshots share them they are
+    /// copied first and this snapshot detaches from the others. The reference
+    /// must not be used once this snapshot has been copied again, the writes
+    /// would be seen by the copies
+    ///
+    auto edit() -> vector_type&
+    {
+        if (not this->m_block)
+            this->m_block = new block_type{ vector_type{} };
+        else if (this->m_block->references.load(std::memory_order_acquire) != 1)
+        {
+            block_type* copy{ new block_type{ vector_type{ this->m_block->elements } } };
+
+            release();
+            this->m_block = copy;
+        }
+
+        return this->m_block->elements;
+    }
+
+    ///
+    /// Turn the snapshot back into a kt::vector, moving the elements out
+    /// when no other snapshot shares them and copying them otherwise
+    ///
+    auto thaw() && -> vector_type
+    {
+        vector_type result{};
+
+        if (this->m_block)
+        {
+            if (this->m_block->references.load(std::memory_order_acquire) == 1)
+                result = std::move(this->m_block->elements);
+            else
+                result = this->m_block->elements;
+
+            release();
+            this->m_block = nullptr;
+        }
+
+        return result;
+    }
+
+    ///
+    /// Returns a constant iterator to the beginning of the snapshot
+    ///
+    auto begin() const -> const_iterator
+    {
+        return get().begin();
+    }
+
+    ///
+    /// Returns a constant iterator past the last element of the snapshot
+    ///
+    auto end() const -> const_iterator
+    {
+        return get().end();
+    }
+
+    auto cbegin() const -> const_iterator
+    {
+        return begin();
+    }
+
+    auto cend() const -> const_iterator
+    {
+        return end();
+    }
+
+private:
+    auto retain() noexcept -> void
+    {
+        if (this->m_block)
+            this->m_block->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto release() noexcept -> void
+    {
+        if (this->m_block and this->m_block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this->m_block;
+    }
+
+    block_type* m_block{};
+
+    // CONSTRAINTS:
+    // m_block is null or m_block->references counts the shared_vectors pointing to it
+};
+
+///
+/// Freeze "source" into a shared_vector, taking over its block in O(1)
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto freeze(vector<T, Alloc, Growth, Errors>&& source) -> shared_vector<T, Alloc, Growth, Errors>
+{
+    return shared_vector<T, Alloc, Growth, Errors>{ std::move(source) };
+}
+
+}   // END KT NAMESPACE
+
+#endif
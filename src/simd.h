@@ -0,0 +1,762 @@
+#ifndef SIMD_HH
+#define SIMD_HH
+
+// C++ standard library includes
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KT_SIMD_X86 1
+#endif
+
+#include "vector.h"
+
+///
+/// Vectorized numeric kernels over contiguous buffers and kt::vector.
+///
+///     floating point: fill, sum, min, max, dot, axpy, scale, clamp
+///     integers:       fill, find, count
+///
+/// Every kernel is compiled for SSE2, AVX2 (with FMA) and AVX-512F plus a
+/// portable scalar version. The best one the CPU supports is picked the first
+/// time a kernel is called. Reductions add lanes in a different order than a
+/// plain loop, so floating point results may differ in the last bits
+///
+namespace kt::simd
+{
+enum class isa
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512
+};
+
+template <typename T>
+struct float_kernels
+{
+    void (*fill)(T*, std::size_t, T);
+    T (*sum)(const T*, std::size_t);
+    T (*min)(const T*, std::size_t);
+    T (*max)(const T*, std::size_t);
+    T (*dot)(const T*, const T*, std::size_t);
+    void (*axpy)(T, const T*, T*, std::size_t);
+    void (*scale)(T*, std::size_t, T);
+    void (*clamp)(T*, std::size_t, T, T);
+};
+
+template <typename T>
+struct integer_kernels
+{
+    void (*fill)(T*, std::size_t, T);
+    std::size_t (*find)(const T*, std::size_t, T);
+    std::size_t (*count)(const T*, std::size_t, T);
+};
+
+// kernels over arrays of 64 bit words, for bit sets
+struct bit_kernels
+{
+    void (*bit_and)(const std::uint64_t*, const std::uint64_t*, std::uint64_t*, std::size_t);
+    void (*bit_or)(const std::uint64_t*, const std::uint64_t*, std::uint64_t*, std::size_t);
+    void (*bit_xor)(const std::uint64_t*, const std::uint64_t*, std::uint64_t*, std::size_t);
+    std::size_t (*popcount)(const std::uint64_t*, std::size_t);
+};
+
+// bit count without the POPCNT instruction, which SSE2 alone does not guarantee
+inline auto swar_popcount(std::uint64_t word) -> std::size_t
+{
+    word -= (word >> 1) & 0x5555555555555555ull;
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+    return static_cast<std::size_t>((word * 0x0101010101010101ull) >> 56);
+}
+
+// portable version, one lane per "register"
+namespace scalar
+{
+    template <typename T>
+    struct lanes
+    {
+        using scalar = T;
+        using reg = T;
+        static constexpr std::size_t width{ 1 };
+
+        static auto zero() -> reg { return T{}; }
+        static auto set1(T value) -> reg { return value; }
+        static auto load(const T* source) -> reg { return *source; }
+        static auto store(T* dest, reg value) -> void { *dest = value; }
+        static auto add(reg lhs, reg rhs) -> reg { return lhs + rhs; }
+        static auto mul(reg lhs, reg rhs) -> reg { return lhs * rhs; }
+        static auto fmadd(reg lhs, reg rhs, reg acc) -> reg { return lhs * rhs + acc; }
+        static auto min(reg lhs, reg rhs) -> reg { return rhs < lhs ? rhs : lhs; }
+        static auto max(reg lhs, reg rhs) -> reg { return lhs < rhs ? rhs : lhs; }
+        static auto eq_mask(reg lhs, reg rhs) -> unsigned { return lhs == rhs; }
+    };
+
+    struct b64
+    {
+        using scalar = std::uint64_t;
+        using reg = std::uint64_t;
+        static constexpr std::size_t width{ 1 };
+
+        static auto load(const scalar* source) -> reg { return *source; }
+        static auto store(scalar* dest, reg value) -> void { *dest = value; }
+        static auto bit_and(reg lhs, reg rhs) -> reg { return lhs & rhs; }
+        static auto bit_or(reg lhs, reg rhs) -> reg { return lhs | rhs; }
+        static auto bit_xor(reg lhs, reg rhs) -> reg { return lhs ^ rhs; }
+        static auto popcount(scalar word) -> std::size_t { return swar_popcount(word); }
+    };
+
+    using f32 = lanes<float>;
+    using f64 = lanes<double>;
+    using i32 = lanes<std::int32_t>;
+    using i64 = lanes<std::int64_t>;
+
+#include "simd_kernels.inl"
+}
+
+#if defined(KT_SIMD_X86)
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace sse2
+{
+    struct f32
+    {
+        using scalar = float;
+        using reg = __m128;
+        static constexpr std::size_t width{ 4 };
+
+        static auto zero() -> reg { return _mm_setzero_ps(); }
+        static auto set1(scalar value) -> reg { return _mm_set1_ps(value); }
+        static auto load(const scalar* source) -> reg { return _mm_loadu_ps(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm_storeu_ps(dest, value); }
+        static auto add(reg lhs, reg rhs) -> reg { return _mm_add_ps(lhs, rhs); }
+        static auto mul(reg lhs, reg rhs) -> reg { return _mm_mul_ps(lhs, rhs); }
+        static auto fmadd(reg lhs, reg rhs, reg acc) -> reg { return _mm_add_ps(_mm_mul_ps(lhs, rhs), acc); }
+        static auto min(reg lhs, reg rhs) -> reg { return _mm_min_ps(lhs, rhs); }
+        static auto max(reg lhs, reg rhs) -> reg { return _mm_max_ps(lhs, rhs); }
+    };
+
+    struct f64
+    {
+        using scalar = double;
+        using reg = __m128d;
+        static constexpr std::size_t width{ 2 };
+
+        static auto zero() -> reg { return _mm_setzero_pd(); }
+        static auto set1(scalar value) -> reg { return _mm_set1_pd(value); }
+        static auto load(const scalar* source) -> reg { return _mm_loadu_pd(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm_storeu_pd(dest, value); }
+        static auto add(reg lhs, reg rhs) -> reg { return _mm_add_pd(lhs, rhs); }
+        static auto mul(reg lhs, reg rhs) -> reg { return _mm_mul_pd(lhs, rhs); }
+        static auto fmadd(reg lhs, reg rhs, reg acc) -> reg { return _mm_add_pd(_mm_mul_pd(lhs, rhs), acc); }
+        static auto min(reg lhs, reg rhs) -> reg { return _mm_min_pd(lhs, rhs); }
+        static auto max(reg lhs, reg rhs) -> reg { return _mm_max_pd(lhs, rhs); }
+    };
+
+    struct i32
+    {
+        using scalar = std::int32_t;
+        using reg = __m128i;
+        static constexpr std::size_t width{ 4 };
+
+        static auto set1(scalar value) -> reg { return _mm_set1_epi32(value); }
+        static auto load(const scalar* source) -> reg { return _mm_loadu_si128(reinterpret_cast<const reg*>(source)); }
+        static auto store(scalar* dest, reg value) -> void { _mm_storeu_si128(reinterpret_cast<reg*>(dest), value); }
+
+        static auto eq_mask(reg lhs, reg rhs) -> unsigned
+        {
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs))));
+        }
+    };
+
+    struct i64
+    {
+        using scalar = std::int64_t;
+        using reg = __m128i;
+        static constexpr std::size_t width{ 2 };
+
+        static auto set1(scalar value) -> reg { return _mm_set1_epi64x(value); }
+        static auto load(const scalar* source) -> reg { return _mm_loadu_si128(reinterpret_cast<const reg*>(source)); }
+        static auto store(scalar* dest, reg value) -> void { _mm_storeu_si128(reinterpret_cast<reg*>(dest), value); }
+
+        // SSE2 has no 64 bit compare, both 32 bit halves have to match
+        static auto eq_mask(reg lhs, reg rhs) -> unsigned
+        {
+            const reg halves{ _mm_cmpeq_epi32(lhs, rhs) };
+            const reg both{ _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1))) };
+
+            return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(both)));
+        }
+    };
+
+    struct b64
+    {
+        using scalar = std::uint64_t;
+        using reg = __m128i;
+        static constexpr std::size_t width{ 2 };
+
+        static auto load(const scalar* source) -> reg { return _mm_loadu_si128(reinterpret_cast<const reg*>(source)); }
+        static auto store(scalar* dest, reg value) -> void { _mm_storeu_si128(reinterpret_cast<reg*>(dest), value); }
+        static auto bit_and(reg lhs, reg rhs) -> reg { return _mm_and_si128(lhs, rhs); }
+        static auto bit_or(reg lhs, reg rhs) -> reg { return _mm_or_si128(lhs, rhs); }
+        static auto bit_xor(reg lhs, reg rhs) -> reg { return _mm_xor_si128(lhs, rhs); }
+        static auto popcount(scalar word) -> std::size_t { return swar_popcount(word); }
+    };
+
+#include "simd_kernels.inl"
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma,popcnt")
+namespace avx2
+{
+    struct f32
+    {
+        using scalar = float;
+        using reg = __m256;
+        static constexpr std::size_t width{ 8 };
+
+        static auto zero() -> reg { return _mm256_setzero_ps(); }
+        static auto set1(scalar value) -> reg { return _mm256_set1_ps(value); }
+        static auto load(const scalar* source) -> reg { return _mm256_loadu_ps(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm256_storeu_ps(dest, value); }
+        static auto add(reg lhs, reg rhs) -> reg { return _mm256_add_ps(lhs, rhs); }
+        static auto mul(reg lhs, reg rhs) -> reg { return _mm256_mul_ps(lhs, rhs); }
+        static auto fmadd(reg lhs, reg rhs, reg acc) -> reg { return _mm256_fmadd_ps(lhs, rhs, acc); }
+        static auto min(reg lhs, reg rhs) -> reg { return _mm256_min_ps(lhs, rhs); }
+        static auto max(reg lhs, reg rhs) -> reg { return _mm256_max_ps(lhs, rhs); }
+    };
+
+    struct f64
+    {
+        using scalar = double;
+        using reg = __m256d;
+        static constexpr std::size_t width{ 4 };
+
+        static auto zero() -> reg { return _mm256_setzero_pd(); }
+        static auto set1(scalar value) -> reg { return _mm256_set1_pd(value); }
+        static auto load(const scalar* source) -> reg { return _mm256_loadu_pd(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm256_storeu_pd(dest, value); }
+        static auto add(reg lhs, reg rhs) -> reg { return _mm256_add_pd(lhs, rhs); }
+        static auto mul(reg lhs, reg rhs) -> reg { return _mm256_mul_pd(lhs, rhs); }
+        static auto fmadd(reg lhs, reg rhs, reg acc) -> reg { return _mm256_fmadd_pd(lhs, rhs, acc); }
+        static auto min(reg lhs, reg rhs) -> reg { return _mm256_min_pd(lhs, rhs); }
+        static auto max(reg lhs, reg rhs) -> reg { return _mm256_max_pd(lhs, rhs); }
+    };
+
+    struct i32
+    {
+        using scalar = std::int32_t;
+        using reg = __m256i;
+        static constexpr std::size_t width{ 8 };
+
+        static auto set1(scalar value) -> reg { return _mm256_set1_epi32(value); }
+        static auto load(const scalar* source) -> reg { return _mm256_loadu_si256(reinterpret_cast<const reg*>(source)); }
+        static auto store(scalar* dest, reg value) -> void { _mm256_storeu_si256(reinterpret_cast<reg*>(dest), value); }
+
+        static auto eq_mask(reg lhs, reg rhs) -> unsigned
+        {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs))));
+        }
+    };
+
+    struct i64
+    {
+        using scalar = std::int64_t;
+        using reg = __m256i;
+        static constexpr std::size_t width{ 4 };
+
+        static auto set1(scalar value) -> reg { return _mm256_set1_epi64x(value); }
+        static auto load(const scalar* source) -> reg { return _mm256_loadu_si256(reinterpret_cast<const reg*>(source)); }
+        static auto store(scalar* dest, reg value) -> void { _mm256_storeu_si256(reinterpret_cast<reg*>(dest), value); }
+
+        static auto eq_mask(reg lhs, reg rhs) -> unsigned
+        {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs))));
+        }
+    };
+
+    struct b64
+    {
+        using scalar = std::uint64_t;
+        using reg = __m256i;
+        static constexpr std::size_t width{ 4 };
+
+        static auto load(const scalar* source) -> reg { return _mm256_loadu_si256(reinterpret_cast<const reg*>(source)); }
+        static auto store(scalar* dest, reg value) -> void { _mm256_storeu_si256(reinterpret_cast<reg*>(dest), value); }
+        static auto bit_and(reg lhs, reg rhs) -> reg { return _mm256_and_si256(lhs, rhs); }
+        static auto bit_or(reg lhs, reg rhs) -> reg { return _mm256_or_si256(lhs, rhs); }
+        static auto bit_xor(reg lhs, reg rhs) -> reg { return _mm256_xor_si256(lhs, rhs); }
+        static auto popcount(scalar word) -> std::size_t { return static_cast<std::size_t>(__builtin_popcountll(word)); }
+    };
+
+#include "simd_kernels.inl"
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,popcnt")
+namespace avx512
+{
+    // min and max go through the masked forms with every lane selected, the
+    // unmasked ones merge into an undefined register that GCC 12 warns about
+    struct f32
+    {
+        using scalar = float;
+        using reg = __m512;
+        static constexpr std::size_t width{ 16 };
+
+        static auto zero() -> reg { return _mm512_setzero_ps(); }
+        static auto set1(scalar value) -> reg { return _mm512_set1_ps(value); }
+        static auto load(const scalar* source) -> reg { return _mm512_loadu_ps(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm512_storeu_ps(dest, value); }
+        static auto add(reg lhs, reg rhs) -> reg { return _mm512_add_ps(lhs, rhs); }
+        static auto mul(reg lhs, reg rhs) -> reg { return _mm512_mul_ps(lhs, rhs); }
+        static auto fmadd(reg lhs, reg rhs, reg acc) -> reg { return _mm512_fmadd_ps(lhs, rhs, acc); }
+        static auto min(reg lhs, reg rhs) -> reg { return _mm512_mask_min_ps(lhs, 0xFFFF, lhs, rhs); }
+        static auto max(reg lhs, reg rhs) -> reg { return _mm512_mask_max_ps(lhs, 0xFFFF, lhs, rhs); }
+    };
+
+    struct f64
+    {
+        using scalar = double;
+        using reg = __m512d;
+        static constexpr std::size_t width{ 8 };
+
+        static auto zero() -> reg { return _mm512_setzero_pd(); }
+        static auto set1(scalar value) -> reg { return _mm512_set1_pd(value); }
+        static auto load(const scalar* source) -> reg { return _mm512_loadu_pd(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm512_storeu_pd(dest, value); }
+        static auto add(reg lhs, reg rhs) -> reg { return _mm512_add_pd(lhs, rhs); }
+        static auto mul(reg lhs, reg rhs) -> reg { return _mm512_mul_pd(lhs, rhs); }
+        static auto fmadd(reg lhs, reg rhs, reg acc) -> reg { return _mm512_fmadd_pd(lhs, rhs, acc); }
+        static auto min(reg lhs, reg rhs) -> reg { return _mm512_mask_min_pd(lhs, 0xFF, lhs, rhs); }
+        static auto max(reg lhs, reg rhs) -> reg { return _mm512_mask_max_pd(lhs, 0xFF, lhs, rhs); }
+    };
+
+    struct i32
+    {
+        using scalar = std::int32_t;
+        using reg = __m512i;
+        static constexpr std::size_t width{ 16 };
+
+        static auto set1(scalar value) -> reg { return _mm512_set1_epi32(value); }
+        static auto load(const scalar* source) -> reg { return _mm512_loadu_si512(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm512_storeu_si512(dest, value); }
+        static auto eq_mask(reg lhs, reg rhs) -> unsigned { return _mm512_cmpeq_epi32_mask(lhs, rhs); }
+    };
+
+    struct i64
+    {
+        using scalar = std::int64_t;
+        using reg = __m512i;
+        static constexpr std::size_t width{ 8 };
+
+        static auto set1(scalar value) -> reg { return _mm512_set1_epi64(value); }
+        static auto load(const scalar* source) -> reg { return _mm512_loadu_si512(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm512_storeu_si512(dest, value); }
+        static auto eq_mask(reg lhs, reg rhs) -> unsigned { return _mm512_cmpeq_epi64_mask(lhs, rhs); }
+    };
+
+    struct b64
+    {
+        using scalar = std::uint64_t;
+        using reg = __m512i;
+        static constexpr std::size_t width{ 8 };
+
+        static auto load(const scalar* source) -> reg { return _mm512_loadu_si512(source); }
+        static auto store(scalar* dest, reg value) -> void { _mm512_storeu_si512(dest, value); }
+        static auto bit_and(reg lhs, reg rhs) -> reg { return _mm512_and_si512(lhs, rhs); }
+        static auto bit_or(reg lhs, reg rhs) -> reg { return _mm512_or_si512(lhs, rhs); }
+        static auto bit_xor(reg lhs, reg rhs) -> reg { return _mm512_xor_si512(lhs, rhs); }
+        static auto popcount(scalar word) -> std::size_t { return static_cast<std::size_t>(__builtin_popcountll(word)); }
+    };
+
+#include "simd_kernels.inl"
+}
+#pragma GCC pop_options
+
+#endif
+
+///
+/// Best instruction set supported by the CPU (and the OS, for the AVX state)
+///
+inline auto detect_isa() -> isa
+{
+#if defined(KT_SIMD_X86)
+    __builtin_cpu_init();
+
+    if (not __builtin_cpu_supports("popcnt"))
+        return __builtin_cpu_supports("sse2") ? isa::sse2 : isa::scalar;
+    if (__builtin_cpu_supports("avx512f"))
+        return isa::avx512;
+    if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+        return isa::avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return isa::sse2;
+#endif
+    return isa::scalar;
+}
+
+namespace detail
+{
+    inline auto selected_isa() -> isa&
+    {
+        static isa selected{ detect_isa() };
+        return selected;
+    }
+
+    // integer kernels work on the bit pattern, signedness does not matter
+    template <typename T>
+    using integer_lanes = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+
+    template <typename T>
+    inline constexpr bool is_float_kernel_type{ std::is_same_v<T, float> or std::is_same_v<T, double> };
+
+    template <typename T>
+    inline constexpr bool is_integer_kernel_type{ std::is_integral_v<T> and not std::is_same_v<T, bool>
+        and (sizeof(T) == 4 or sizeof(T) == 8) };
+
+    template <typename T, typename Lanes32, typename Lanes64>
+    using pick = std::conditional_t<sizeof(T) == 4, Lanes32, Lanes64>;
+
+    template <typename T>
+    auto make_float_kernels(isa target) -> float_kernels<T>
+    {
+        switch (target)
+        {
+#if defined(KT_SIMD_X86)
+            case isa::avx512: return avx512::float_table<T, pick<T, avx512::f32, avx512::f64>>();
+            case isa::avx2:   return avx2::float_table<T, pick<T, avx2::f32, avx2::f64>>();
+            case isa::sse2:   return sse2::float_table<T, pick<T, sse2::f32, sse2::f64>>();
+#endif
+            default:          return scalar::float_table<T, pick<T, scalar::f32, scalar::f64>>();
+        }
+    }
+
+    template <typename T>
+    auto make_integer_kernels(isa target) -> integer_kernels<T>
+    {
+        switch (target)
+        {
+#if defined(KT_SIMD_X86)
+            case isa::avx512: return avx512::integer_table<T, pick<T, avx512::i32, avx512::i64>>();
+            case isa::avx2:   return avx2::integer_table<T, pick<T, avx2::i32, avx2::i64>>();
+            case isa::sse2:   return sse2::integer_table<T, pick<T, sse2::i32, sse2::i64>>();
+#endif
+            default:          return scalar::integer_table<T, pick<T, scalar::i32, scalar::i64>>();
+        }
+    }
+
+    inline auto make_bit_kernels(isa target) -> bit_kernels
+    {
+        switch (target)
+        {
+#if defined(KT_SIMD_X86)
+            case isa::avx512: return avx512::bit_table<avx512::b64>();
+            case isa::avx2:   return avx2::bit_table<avx2::b64>();
+            case isa::sse2:   return sse2::bit_table<sse2::b64>();
+#endif
+            default:          return scalar::bit_table<scalar::b64>();
+        }
+    }
+
+    // the table of every type is rebuilt whenever the selected instruction set changes
+    template <typename T>
+    auto float_kernels_for() -> const float_kernels<T>&
+    {
+        static isa built_for{ selected_isa() };
+        static float_kernels<T> table{ make_float_kernels<T>(built_for) };
+
+        if (built_for != selected_isa())
+        {
+            built_for = selected_isa();
+            table = make_float_kernels<T>(built_for);
+        }
+
+        return table;
+    }
+
+    template <typename T>
+    auto integer_kernels_for() -> const integer_kernels<integer_lanes<T>>&
+    {
+        using lanes = integer_lanes<T>;
+
+        static isa built_for{ selected_isa() };
+        static integer_kernels<lanes> table{ make_integer_kernels<lanes>(built_for) };
+
+        if (built_for != selected_isa())
+        {
+            built_for = selected_isa();
+            table = make_integer_kernels<lanes>(built_for);
+        }
+
+        return table;
+    }
+
+    inline auto bit_kernels_for() -> const bit_kernels&
+    {
+        static isa built_for{ selected_isa() };
+        static bit_kernels table{ make_bit_kernels(built_for) };
+
+        if (built_for != selected_isa())
+        {
+            built_for = selected_isa();
+            table = make_bit_kernels(built_for);
+        }
+
+        return table;
+    }
+
+    template <typename T>
+    auto bits_of(T value) -> integer_lanes<T>
+    {
+        integer_lanes<T> bits;
+        std::memcpy(&bits, &value, sizeof(T));
+
+        return bits;
+    }
+}
+
+///
+/// Instruction set the kernels currently run on
+///
+inline auto active_isa() -> isa
+{
+    return detail::selected_isa();
+}
+
+///
+/// Run the kernels on "target" instead of the detected instruction set, for
+/// benchmarks and tests. Requests above what the CPU supports are capped.
+/// Not meant to be called while other threads are running kernels
+///
+inline auto force_isa(isa target) -> void
+{
+    detail::selected_isa() = std::min(target, detect_isa());
+}
+
+///
+/// Set "count" elements starting at "data" to "value"
+///
+template <typename T>
+auto fill(T* data, std::size_t count, T value) -> void
+{
+    if constexpr (detail::is_float_kernel_type<T>)
+        detail::float_kernels_for<T>().fill(data, count, value);
+    else if constexpr (detail::is_integer_kernel_type<T>)
+        detail::integer_kernels_for<T>().fill(reinterpret_cast<detail::integer_lanes<T>*>(data), count,
+            detail::bits_of(value));
+    else
+        std::fill_n(data, count, value);
+}
+
+///
+/// Sum of "count" elements starting at "data"
+///
+template <typename T>
+auto sum(const T* data, std::size_t count) -> T
+{
+    static_assert(detail::is_float_kernel_type<T>, "sum is provided for float and double");
+    return detail::float_kernels_for<T>().sum(data, count);
+}
+
+///
+/// Smallest of "count" elements starting at "data", +infinity if there are none
+///
+template <typename T>
+auto min(const T* data, std::size_t count) -> T
+{
+    static_assert(detail::is_float_kernel_type<T>, "min is provided for float and double");
+    return detail::float_kernels_for<T>().min(data, count);
+}
+
+///
+/// Biggest of "count" elements starting at "data", -infinity if there are none
+///
+template <typename T>
+auto max(const T* data, std::size_t count) -> T
+{
+    static_assert(detail::is_float_kernel_type<T>, "max is provided for float and double");
+    return detail::float_kernels_for<T>().max(data, count);
+}
+
+///
+/// Dot product of the first "count" elements of "lhs" and "rhs"
+///
+template <typename T>
+auto dot(const T* lhs, const T* rhs, std::size_t count) -> T
+{
+    static_assert(detail::is_float_kernel_type<T>, "dot is provided for float and double");
+    return detail::float_kernels_for<T>().dot(lhs, rhs, count);
+}
+
+///
+/// y[i] += alpha * x[i] for the first "count" elements
+///
+template <typename T>
+auto axpy(T alpha, const T* x, T* y, std::size_t count) -> void
+{
+    static_assert(detail::is_float_kernel_type<T>, "axpy is provided for float and double");
+    detail::float_kernels_for<T>().axpy(alpha, x, y, count);
+}
+
+///
+/// Multiply "count" elements starting at "data" by "alpha"
+///
+template <typename T>
+auto scale(T* data, std::size_t count, T alpha) -> void
+{
+    static_assert(detail::is_float_kernel_type<T>, "scale is provided for float and double");
+    detail::float_kernels_for<T>().scale(data, count, alpha);
+}
+
+///
+/// Limit "count" elements starting at "data" to the range ["low", "high"]
+///
+template <typename T>
+auto clamp(T* data, std::size_t count, T low, T high) -> void
+{
+    static_assert(detail::is_float_kernel_type<T>, "clamp is provided for float and double");
+    detail::float_kernels_for<T>().clamp(data, count, low, high);
+}
+
+///
+/// Index of the first element equal to "value", "count" if there is none
+///
+template <typename T>
+auto find(const T* data, std::size_t count, T value) -> std::size_t
+{
+    static_assert(detail::is_integer_kernel_type<T>, "find is provided for 32 and 64 bit integers");
+    return detail::integer_kernels_for<T>().find(reinterpret_cast<const detail::integer_lanes<T>*>(data), count,
+        detail::bits_of(value));
+}
+
+///
+/// Amount of elements equal to "value"
+///
+template <typename T>
+auto count(const T* data, std::size_t count, T value) -> std::size_t
+{
+    static_assert(detail::is_integer_kernel_type<T>, "count is provided for 32 and 64 bit integers");
+    return detail::integer_kernels_for<T>().count(reinterpret_cast<const detail::integer_lanes<T>*>(data), count,
+        detail::bits_of(value));
+}
+
+///
+/// out[i] = lhs[i] & rhs[i] for "count" 64 bit words. "out" may be "lhs" or "rhs"
+///
+inline auto bit_and(const std::uint64_t* lhs, const std::uint64_t* rhs, std::uint64_t* out, std::size_t count) -> void
+{
+    detail::bit_kernels_for().bit_and(lhs, rhs, out, count);
+}
+
+///
+/// out[i] = lhs[i] | rhs[i] for "count" 64 bit words. "out" may be "lhs" or "rhs"
+///
+inline auto bit_or(const std::uint64_t* lhs, const std::uint64_t* rhs, std::uint64_t* out, std::size_t count) -> void
+{
+    detail::bit_kernels_for().bit_or(lhs, rhs, out, count);
+}
+
+///
+/// out[i] = lhs[i] ^ rhs[i] for "count" 64 bit words. "out" may be "lhs" or "rhs"
+///
+inline auto bit_xor(const std::uint64_t* lhs, const std::uint64_t* rhs, std::uint64_t* out, std::size_t count) -> void
+{
+    detail::bit_kernels_for().bit_xor(lhs, rhs, out, count);
+}
+
+///
+/// Amount of set bits in "count" 64 bit words
+///
+inline auto popcount(const std::uint64_t* words, std::size_t count) -> std::size_t
+{
+    return detail::bit_kernels_for().popcount(words, count);
+}
+
+//
+// kt::vector overloads
+//
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto fill(vector<T, Alloc, Growth, Errors>& values, T value) -> void
+{
+    fill(values.data(), values.size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto sum(const vector<T, Alloc, Growth, Errors>& values) -> T
+{
+    return sum(values.data(), values.size());
+}
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto min(const vector<T, Alloc, Growth, Errors>& values) -> T
+{
+    return min(values.data(), values.size());
+}
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto max(const vector<T, Alloc, Growth, Errors>& values) -> T
+{
+    return max(values.data(), values.size());
+}
+
+///
+/// Dot product over the elements both vectors have
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto dot(const vector<T, Alloc, Growth, Errors>& lhs, const vector<T, Alloc, Growth, Errors>& rhs) -> T
+{
+    return dot(lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size()));
+}
+
+///
+/// y[i] += alpha * x[i] over the elements both vectors have
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto axpy(T alpha, const vector<T, Alloc, Growth, Errors>& x, vector<T, Alloc, Growth, Errors>& y) -> void
+{
+    axpy(alpha, x.data(), y.data(), std::min(x.size(), y.size()));
+}
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto scale(vector<T, Alloc, Growth, Errors>& values, T alpha) -> void
+{
+    scale(values.data(), values.size(), alpha);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto clamp(vector<T, Alloc, Growth, Errors>& values, T low, T high) -> void
+{
+    clamp(values.data(), values.size(), low, high);
+}
+
+///
+/// Index of the first element equal to "value", size() if there is none
+///
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto find(const vector<T, Alloc, Growth, Errors>& values, T value) -> std::size_t
+{
+    return find(values.data(), values.size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto count(const vector<T, Alloc, Growth, Errors>& values, T value) -> std::size_t
+{
+    return count(values.data(), values.size(), value);
+}
+
+}   // END KT::SIMD NAMESPACE
+
+#endif
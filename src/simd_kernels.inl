@@ -0,0 +1,326 @@
+// Generic numeric kernels shared by every instruction set in simd.h.
+//
+// This file is included once per instruction set, inside the namespace of
+// that instruction set and under the matching "#pragma GCC target", right
+// after the lane traits f32, f64, i32, i64 and b64 have been defined. Each trait
+// provides the scalar and register types, the lane count and the primitive
+// operations the kernels below are written against. Do not include it anywhere else
+
+template <typename V>
+inline auto reduce_add(typename V::reg value) -> typename V::scalar
+{
+    typename V::scalar lanes[V::width];
+    V::store(lanes, value);
+
+    typename V::scalar result{ lanes[0] };
+    for (std::size_t lane{ 1 }; lane < V::width; ++lane)
+        result += lanes[lane];
+
+    return result;
+}
+
+template <typename V>
+inline auto reduce_min(typename V::reg value) -> typename V::scalar
+{
+    typename V::scalar lanes[V::width];
+    V::store(lanes, value);
+
+    typename V::scalar result{ lanes[0] };
+    for (std::size_t lane{ 1 }; lane < V::width; ++lane)
+        result = lanes[lane] < result ? lanes[lane] : result;
+
+    return result;
+}
+
+template <typename V>
+inline auto reduce_max(typename V::reg value) -> typename V::scalar
+{
+    typename V::scalar lanes[V::width];
+    V::store(lanes, value);
+
+    typename V::scalar result{ lanes[0] };
+    for (std::size_t lane{ 1 }; lane < V::width; ++lane)
+        result = lanes[lane] > result ? lanes[lane] : result;
+
+    return result;
+}
+
+// number of set bits in the lane mask of one register. Masks of up to four
+// lanes use a table since SSE2 alone does not guarantee the POPCNT instruction
+template <typename V>
+inline auto mask_popcount(unsigned mask) -> std::size_t
+{
+    if constexpr (V::width <= 4)
+    {
+        static constexpr unsigned char nibble_bits[16]{ 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+        return nibble_bits[mask];
+    }
+    else
+        return static_cast<std::size_t>(__builtin_popcount(mask));
+}
+
+template <typename V>
+auto fill(typename V::scalar* data, std::size_t count, typename V::scalar value) -> void
+{
+    const typename V::reg broadcast{ V::set1(value) };
+    std::size_t index{};
+
+    for (; index + V::width <= count; index += V::width)
+        V::store(data + index, broadcast);
+
+    for (; index < count; ++index)
+        data[index] = value;
+}
+
+template <typename V>
+auto sum(const typename V::scalar* data, std::size_t count) -> typename V::scalar
+{
+    // four independent accumulators hide the latency of the additions
+    typename V::reg acc0{ V::zero() }, acc1{ V::zero() }, acc2{ V::zero() }, acc3{ V::zero() };
+    std::size_t index{};
+
+    for (; index + 4 * V::width <= count; index += 4 * V::width)
+    {
+        acc0 = V::add(acc0, V::load(data + index));
+        acc1 = V::add(acc1, V::load(data + index + V::width));
+        acc2 = V::add(acc2, V::load(data + index + 2 * V::width));
+        acc3 = V::add(acc3, V::load(data + index + 3 * V::width));
+    }
+
+    for (; index + V::width <= count; index += V::width)
+        acc0 = V::add(acc0, V::load(data + index));
+
+    typename V::scalar result{ reduce_add<V>(V::add(V::add(acc0, acc1), V::add(acc2, acc3))) };
+
+    for (; index < count; ++index)
+        result += data[index];
+
+    return result;
+}
+
+template <typename V>
+auto min(const typename V::scalar* data, std::size_t count) -> typename V::scalar
+{
+    using scalar = typename V::scalar;
+
+    scalar result{ std::numeric_limits<scalar>::has_infinity
+        ? std::numeric_limits<scalar>::infinity() : std::numeric_limits<scalar>::max() };
+    std::size_t index{};
+
+    if (count >= 2 * V::width)
+    {
+        typename V::reg acc0{ V::load(data) }, acc1{ V::load(data + V::width) };
+
+        for (index = 2 * V::width; index + 2 * V::width <= count; index += 2 * V::width)
+        {
+            acc0 = V::min(acc0, V::load(data + index));
+            acc1 = V::min(acc1, V::load(data + index + V::width));
+        }
+
+        result = reduce_min<V>(V::min(acc0, acc1));
+    }
+
+    for (; index < count; ++index)
+        result = data[index] < result ? data[index] : result;
+
+    return result;
+}
+
+template <typename V>
+auto max(const typename V::scalar* data, std::size_t count) -> typename V::scalar
+{
+    using scalar = typename V::scalar;
+
+    scalar result{ std::numeric_limits<scalar>::has_infinity
+        ? -std::numeric_limits<scalar>::infinity() : std::numeric_limits<scalar>::lowest() };
+    std::size_t index{};
+
+    if (count >= 2 * V::width)
+    {
+        typename V::reg acc0{ V::load(data) }, acc1{ V::load(data + V::width) };
+
+        for (index = 2 * V::width; index + 2 * V::width <= count; index += 2 * V::width)
+        {
+            acc0 = V::max(acc0, V::load(data + index));
+            acc1 = V::max(acc1, V::load(data + index + V::width));
+        }
+
+        result = reduce_max<V>(V::max(acc0, acc1));
+    }
+
+    for (; index < count; ++index)
+        result = data[index] > result ? data[index] : result;
+
+    return result;
+}
+
+template <typename V>
+auto dot(const typename V::scalar* lhs, const typename V::scalar* rhs, std::size_t count) -> typename V::scalar
+{
+    typename V::reg acc0{ V::zero() }, acc1{ V::zero() }, acc2{ V::zero() }, acc3{ V::zero() };
+    std::size_t index{};
+
+    for (; index + 4 * V::width <= count; index += 4 * V::width)
+    {
+        acc0 = V::fmadd(V::load(lhs + index), V::load(rhs + index), acc0);
+        acc1 = V::fmadd(V::load(lhs + index + V::width), V::load(rhs + index + V::width), acc1);
+        acc2 = V::fmadd(V::load(lhs + index + 2 * V::width), V::load(rhs + index + 2 * V::width), acc2);
+        acc3 = V::fmadd(V::load(lhs + index + 3 * V::width), V::load(rhs + index + 3 * V::width), acc3);
+    }
+
+    for (; index + V::width <= count; index += V::width)
+        acc0 = V::fmadd(V::load(lhs + index), V::load(rhs + index), acc0);
+
+    typename V::scalar result{ reduce_add<V>(V::add(V::add(acc0, acc1), V::add(acc2, acc3))) };
+
+    for (; index < count; ++index)
+        result += lhs[index] * rhs[index];
+
+    return result;
+}
+
+template <typename V>
+auto axpy(typename V::scalar alpha, const typename V::scalar* x, typename V::scalar* y, std::size_t count) -> void
+{
+    const typename V::reg factor{ V::set1(alpha) };
+    std::size_t index{};
+
+    for (; index + V::width <= count; index += V::width)
+        V::store(y + index, V::fmadd(factor, V::load(x + index), V::load(y + index)));
+
+    for (; index < count; ++index)
+        y[index] += alpha * x[index];
+}
+
+template <typename V>
+auto scale(typename V::scalar* data, std::size_t count, typename V::scalar alpha) -> void
+{
+    const typename V::reg factor{ V::set1(alpha) };
+    std::size_t index{};
+
+    for (; index + V::width <= count; index += V::width)
+        V::store(data + index, V::mul(V::load(data + index), factor));
+
+    for (; index < count; ++index)
+        data[index] *= alpha;
+}
+
+template <typename V>
+auto clamp(typename V::scalar* data, std::size_t count, typename V::scalar low, typename V::scalar high) -> void
+{
+    const typename V::reg lower{ V::set1(low) };
+    const typename V::reg upper{ V::set1(high) };
+    std::size_t index{};
+
+    for (; index + V::width <= count; index += V::width)
+        V::store(data + index, V::min(V::max(V::load(data + index), lower), upper));
+
+    for (; index < count; ++index)
+        data[index] = data[index] < low ? low : (data[index] > high ? high : data[index]);
+}
+
+template <typename V>
+auto find(const typename V::scalar* data, std::size_t count, typename V::scalar value) -> std::size_t
+{
+    const typename V::reg needle{ V::set1(value) };
+    std::size_t index{};
+
+    for (; index + V::width <= count; index += V::width)
+        if (const unsigned mask{ V::eq_mask(V::load(data + index), needle) }; mask != 0)
+            return index + static_cast<std::size_t>(__builtin_ctz(mask));
+
+    for (; index < count; ++index)
+        if (data[index] == value)
+            return index;
+
+    return count;
+}
+
+template <typename V>
+auto count(const typename V::scalar* data, std::size_t length, typename V::scalar value) -> std::size_t
+{
+    const typename V::reg needle{ V::set1(value) };
+    std::size_t matches{};
+    std::size_t index{};
+
+    for (; index + V::width <= length; index += V::width)
+        matches += mask_popcount<V>(V::eq_mask(V::load(data + index), needle));
+
+    for (; index < length; ++index)
+        matches += data[index] == value;
+
+    return matches;
+}
+
+// the three bitwise kernels only differ in the operation, picked by these tags
+struct and_words
+{
+    template <typename V>
+    static auto apply(typename V::reg lhs, typename V::reg rhs) -> typename V::reg { return V::bit_and(lhs, rhs); }
+    static auto apply(std::uint64_t lhs, std::uint64_t rhs) -> std::uint64_t { return lhs & rhs; }
+};
+
+struct or_words
+{
+    template <typename V>
+    static auto apply(typename V::reg lhs, typename V::reg rhs) -> typename V::reg { return V::bit_or(lhs, rhs); }
+    static auto apply(std::uint64_t lhs, std::uint64_t rhs) -> std::uint64_t { return lhs | rhs; }
+};
+
+struct xor_words
+{
+    template <typename V>
+    static auto apply(typename V::reg lhs, typename V::reg rhs) -> typename V::reg { return V::bit_xor(lhs, rhs); }
+    static auto apply(std::uint64_t lhs, std::uint64_t rhs) -> std::uint64_t { return lhs ^ rhs; }
+};
+
+template <typename V, typename Operation>
+auto bitwise(const std::uint64_t* lhs, const std::uint64_t* rhs, std::uint64_t* out, std::size_t count) -> void
+{
+    std::size_t index{};
+
+    for (; index + V::width <= count; index += V::width)
+        V::store(out + index, Operation::template apply<V>(V::load(lhs + index), V::load(rhs + index)));
+
+    for (; index < count; ++index)
+        out[index] = Operation::apply(lhs[index], rhs[index]);
+}
+
+template <typename V>
+auto popcount(const std::uint64_t* words, std::size_t count) -> std::size_t
+{
+    // four independent sums keep the popcounts from waiting on each other
+    std::size_t sum0{}, sum1{}, sum2{}, sum3{};
+    std::size_t index{};
+
+    for (; index + 4 <= count; index += 4)
+    {
+        sum0 += V::popcount(words[index]);
+        sum1 += V::popcount(words[index + 1]);
+        sum2 += V::popcount(words[index + 2]);
+        sum3 += V::popcount(words[index + 3]);
+    }
+
+    for (; index < count; ++index)
+        sum0 += V::popcount(words[index]);
+
+    return sum0 + sum1 + sum2 + sum3;
+}
+
+template <typename T, typename V>
+auto float_table() -> float_kernels<T>
+{
+    return { &fill<V>, &sum<V>, &min<V>, &max<V>, &dot<V>, &axpy<V>, &scale<V>, &clamp<V> };
+}
+
+template <typename T, typename V>
+auto integer_table() -> integer_kernels<T>
+{
+    return { &fill<V>, &find<V>, &count<V> };
+}
+
+template <typename V>
+auto bit_table() -> bit_kernels
+{
+    return { &bitwise<V, and_words>, &bitwise<V, or_words>, &bitwise<V, xor_words>, &popcount<V> };
+}
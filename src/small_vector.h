@@ -0,0 +1,549 @@
+#ifndef SMALL_VECTOR_HH
+#define SMALL_VECTOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+
+#include "vector.h"
+#include "relocation.h"
+#include "error_policy.h"
+#include "growth_policy.h"
+
+namespace kt
+{
+///
+/// Vector keeping its first N elements inside the object itself. The heap
+/// is only touched once the vector outgrows its inline storage
+///
+template <typename T, std::size_t N, typename Alloc = std::allocator<T>, typename Growth = grow_double, typename Errors = errors_throw>
+class small_vector
+{
+    static_assert(N > 0, "small_vector needs room for at least one inline element");
+
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+public:
+    using value_type            = T;
+    using allocator_type        = Alloc;
+    using growth_policy         = Growth;
+    using error_policy          = Errors;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    // same iterators as kt::vector so both containers can be used interchangeably
+    using iterator              = typename vector<T, Alloc, Growth>::iterator;
+    using const_iterator        = typename vector<T, Alloc, Growth>::const_iterator;
+
+    static constexpr size_type inline_capacity{ N };
+
+    ///
+    /// Default constructor. The vector starts using its inline storage
+    ///
+    small_vector() noexcept(noexcept(allocator_type()))
+        :   m_alloc{}, m_array{ inline_block() }, m_count{}, m_capacity{ N }
+    {
+
+    }
+
+    ///
+    /// Default constructor. Memory for spilled elements is obtained from "alloc"
+    ///
+    explicit small_vector(const allocator_type& alloc) noexcept
+        :   m_alloc{ alloc }, m_array{ inline_block() }, m_count{}, m_capacity{ N }
+    {
+
+    }
+
+    ///
+    /// Parametrized constructor. Initializes vector
+    /// with the elements from "content"
+    ///
+    small_vector(std::initializer_list<T> content, const allocator_type& alloc = allocator_type())
+        :   small_vector(alloc)
+    {
+        copy_from(content.begin(), content.size());
+    }
+
+    ///
+    /// Copy constructor. Initialize this vector with elements from "other"
+    ///
+    small_vector(const small_vector& other)
+        :   small_vector(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+        copy_from(other.m_array, other.m_count);
+    }
+
+    ///
+    /// Assigment operator. Deep copy of "other"
+    ///
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (this->m_alloc != other.m_alloc)
+                    release_heap_block();
+
+                this->m_alloc = other.m_alloc;
+            }
+
+            copy_from(other.m_array, other.m_count);
+        }
+
+        return *this;
+    }
+
+    ///
+    /// Move constructor. A spilled block is taken over,
+    /// inline elements have to be moved one by one
+    ///
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        :   m_alloc{ std::move(other.m_alloc) }, m_array{ inline_block() }, m_count{}, m_capacity{ N }
+    {
+        take_from(other);
+    }
+
+    ///
+    /// Assigment operator with support for move semantics
+    ///
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>
+        and (alloc_traits::propagate_on_container_move_assignment::value or alloc_traits::is_always_equal::value))
+    {
+        if (this != &other)
+        {
+            clear();
+
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                release_heap_block();
+                this->m_alloc = std::move(other.m_alloc);
+                take_from(other);
+            }
+            else
+            {
+                if (this->m_alloc == other.m_alloc or other.is_inline())
+                {
+                    release_heap_block();
+                    take_from(other);
+                }
+                else
+                {
+                    // the block of "other" can not be freed by our allocator. If
+                    // no block big enough is obtained "other" keeps its elements
+                    if (other.m_count > this->m_capacity and not reallocate(other.m_count))
+                        return *this;
+
+                    relocate_n(this->m_alloc, other.m_array, other.m_count, this->m_array);
+                    this->m_count = other.m_count;
+                    other.m_count = 0;
+                }
+            }
+        }
+
+        return *this;
+    }
+
+    ///
+    /// Destructor
+    ///
+    ~small_vector()
+    {
+        clear();
+        release_heap_block();
+    }
+
+    ///
+    /// Amount of elements in the vector
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_count;
+    }
+
+    ///
+    /// Returns the amount of elements the vector can hold without allocating
+    ///
+    auto capacity() const -> size_type
+    {
+        return this->m_capacity;
+    }
+
+    ///
+    /// Return true if this vector has no elements, fase otherwise
+    ///
+    auto empty() const -> bool
+    {
+        return this->m_count == 0;
+    }
+
+    ///
+    /// Returns true while the elements live in the inline storage
+    ///
+    auto is_inline() const -> bool
+    {
+        return this->m_array == inline_block();
+    }
+
+    ///
+    /// Returns reference to element at postion "index"
+    ///
+    auto operator[](size_type index) -> reference_type
+    {
+        return this->m_array[index];
+    }
+
+    ///
+    /// Returns constant reference to element at postion "index"
+    ///
+    auto operator[](size_type index) const -> const_reference_type
+    {
+        return this->m_array[index];
+    }
+
+    ///
+    /// Reserve a block of memory to hold count elements
+    ///
+    auto reserve(size_type count) -> void
+    {
+        if (count > this->m_capacity)
+            reallocate(count);
+    }
+
+    ///
+    /// Adjust vector to contain count elements. New elements are value initialized
+    ///
+    auto resize(size_type count) -> void
+    {
+        if (count <= this->m_count)
+        {
+            remove_n(this->m_count - count);
+            return;
+        }
+
+        if (count > this->m_capacity and not reallocate(Growth::next_capacity(this->m_capacity, count, sizeof(value_type))))
+            return;
+
+        for (; this->m_count < count; ++this->m_count)
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count);
+    }
+
+    ///
+    /// Move the elements back into the inline storage if they fit,
+    /// otherwise into a heap block exactly as big as needed
+    ///
+    auto shrink_to_fit() -> void
+    {
+        if (is_inline() or this->m_count == this->m_capacity)
+            return;
+
+        if (this->m_count <= N)
+        {
+            relocate_n(this->m_alloc, this->m_array, this->m_count, inline_block());
+            alloc_traits::deallocate(this->m_alloc, this->m_array, this->m_capacity);
+
+            this->m_array = inline_block();
+            this->m_capacity = N;
+
+            return;
+        }
+
+        reallocate(this->m_count);
+    }
+
+    ///
+    /// Insert elements at the end
+    ///
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        if (this->m_count == this->m_capacity)
+        {
+            grow_and_emplace(std::forward<Args>(args)...);
+            return;
+        }
+
+        alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::forward<Args>(args)...);
+        this->m_count += 1;
+    }
+
+    ///
+    /// Insert one element at the end of the vector
+    ///
+    auto push_back(const_reference_type info) -> void
+    {
+        emplace_back(info);
+    }
+
+    ///
+    /// Insert one element at the end of the vector
+    /// with support for move semantics
+    ///
+    auto push_back(T&& info) -> void
+    {
+        emplace_back(std::move(info));
+    }
+
+    ///
+    /// Concatenate the contents of this vector and "other"
+    /// This vector contains the result of the concatenation
+    ///
+    auto append(const small_vector& other) -> void
+    {
+        const size_type other_count{ other.m_count };
+
+        if (other_count == 0)
+            return;
+
+        // "other" may be this vector, so its block is only read after growing
+        if (this->m_capacity - this->m_count < other_count
+            and not reallocate(Growth::next_capacity(this->m_capacity, this->m_count + other_count, sizeof(value_type))))
+            return;
+
+        uninitialized_copy_n(this->m_alloc, static_cast<const T*>(other.m_array), other_count,
+            this->m_array + this->m_count);
+        this->m_count += other_count;
+    }
+
+    ///
+    /// Destroy the last n elements. If there is less than
+    /// count elements, it empties the vector
+    ///
+    auto remove_n(size_type count) -> void
+    {
+        if (count > this->m_count)
+            count = this->m_count;
+
+        destroy_n(this->m_alloc, this->m_array + this->m_count - count, count);
+        this->m_count -= count;
+    }
+
+    ///
+    /// Remove the last element from the vector
+    ///
+    auto pop_back() -> void
+    {
+        if (this->m_count != 0)
+        {
+            alloc_traits::destroy(this->m_alloc, this->m_array + this->m_count - 1);
+            this->m_count -= 1;
+        }
+    }
+
+    ///
+    /// Remove all elements from the vector. The capacity is kept
+    ///
+    auto clear() -> void
+    {
+        destroy_n(this->m_alloc, this->m_array, this->m_count);
+        this->m_count = 0;
+    }
+
+    ///
+    /// Returns an iterator to the beginning of the vector
+    ///
+    auto begin() -> iterator
+    {
+        return iterator{ this->m_array };
+    }
+
+    ///
+    /// Returns an iterator to the element past of the vector
+    ///
+    auto end() -> iterator
+    {
+        return iterator{ this->m_array + this->m_count };
+    }
+
+    ///
+    /// Returns a constant iterator to the beginning of the vector
+    ///
+    auto begin() const -> const_iterator
+    {
+        return const_iterator{ this->m_array };
+    }
+
+    ///
+    /// Returns a constant iterator past the last element of the vector
+    ///
+    auto end() const -> const_iterator
+    {
+        return const_iterator{ this->m_array + this->m_count };
+    }
+
+    ///
+    /// Returns a constant iterator to the beginning of the vector
+    ///
+    auto cbegin() const -> const_iterator
+    {
+        return const_iterator{ this->m_array };
+    }
+
+    ///
+    /// Returns a constant iterator past the last element of the vector
+    ///
+    auto cend() const -> const_iterator
+    {
+        return const_iterator{ this->m_array + this->m_count };
+    }
+
+private:
+    auto inline_block() noexcept -> pointer_type
+    {
+        return std::launder(reinterpret_cast<pointer_type>(this->m_inline));
+    }
+
+    auto inline_block() const noexcept -> pointer_type
+    {
+        return const_cast<small_vector*>(this)->inline_block();
+    }
+
+    auto release_heap_block() noexcept -> void
+    {
+        if (not is_inline())
+        {
+            alloc_traits::deallocate(this->m_alloc, this->m_array, this->m_capacity);
+
+            this->m_array = inline_block();
+            this->m_capacity = N;
+        }
+    }
+
+    // copy "count" elements into this vector, which must be empty
+    auto copy_from(const T* source, size_type count) -> void
+    {
+        if (count > this->m_capacity and not reallocate(count))
+            return;
+
+        uninitialized_copy_n(this->m_alloc, source, count, this->m_array);
+        this->m_count = count;
+    }
+
+    // take the elements of "other", this vector must be empty and inline
+    auto take_from(small_vector& other) -> void
+    {
+        if (other.is_inline())
+        {
+            relocate_n(this->m_alloc, other.m_array, other.m_count, this->m_array);
+        }
+        else
+        {
+            this->m_array = other.m_array;
+            this->m_capacity = other.m_capacity;
+
+            other.m_array = other.inline_block();
+            other.m_capacity = N;
+        }
+
+        this->m_count = other.m_count;
+        other.m_count = 0;
+    }
+
+    ///
+    /// Move every element into a heap block able to hold "new_block_count" elements.
+    /// Returns false, leaving the vector untouched, if the block could not be obtained
+    ///
+    auto reallocate(size_type new_block_count) -> bool
+    {
+        pointer_type new_block{ allocate_block(new_block_count) };
+
+        if (not new_block)
+        {
+            Errors::on_allocation_failure("Failed to allocate new block of memory");
+            return false;
+        }
+
+        try
+        {
+            relocate_n(this->m_alloc, this->m_array, this->m_count, new_block);
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(this->m_alloc, new_block, new_block_count);
+            throw;
+        }
+
+        release_heap_block();
+
+        this->m_array = new_block;
+        this->m_capacity = new_block_count;
+
+        return true;
+    }
+
+    template <typename... Args>
+    auto grow_and_emplace(Args&&... args) -> void
+    {
+        const size_type new_block_count{ Growth::next_capacity(this->m_capacity, this->m_count + 1, sizeof(value_type)) };
+        pointer_type new_block{ allocate_block(new_block_count) };
+
+        if (not new_block)
+        {
+            Errors::on_allocation_failure("could not insert new element due to error while reallocating...");
+            return;
+        }
+
+        // build the new element first, "args" may refer to one of our elements
+        try
+        {
+            alloc_traits::construct(this->m_alloc, new_block + this->m_count, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(this->m_alloc, new_block, new_block_count);
+            throw;
+        }
+
+        try
+        {
+            relocate_n(this->m_alloc, this->m_array, this->m_count, new_block);
+        }
+        catch (...)
+        {
+            alloc_traits::destroy(this->m_alloc, new_block + this->m_count);
+            alloc_traits::deallocate(this->m_alloc, new_block, new_block_count);
+            throw;
+        }
+
+        release_heap_block();
+
+        this->m_array = new_block;
+        this->m_count += 1;
+        this->m_capacity = new_block_count;
+    }
+
+    auto allocate_block(size_type count) -> pointer_type
+    {
+        try
+        {
+            return alloc_traits::allocate(this->m_alloc, count);
+        }
+        catch (const std::bad_alloc&)
+        {
+            return nullptr;
+        }
+    }
+
+    allocator_type m_alloc;
+    pointer_type m_array;
+    size_type m_count;
+    size_type m_capacity;
+    alignas(T) std::byte m_inline[sizeof(T) * N];
+
+    // CONSTRAINTS:
+    // m_capacity >= m_count >= 0
+    // m_capacity == N while m_array points to m_inline
+};
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,597 @@
+#ifndef SOA_VECTOR_HH
+#define SOA_VECTOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <tuple>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <initializer_list>
+
+#include "relocation.h"
+#include "error_policy.h"
+#include "growth_policy.h"
+
+namespace kt
+{
+///
+/// Non-owning view of one column of a soa_vector: a pointer and a size.
+/// Invalidated by anything that reallocates the vector
+///
+template <typename T>
+class column_span
+{
+public:
+    using value_type            = std::remove_const_t<T>;
+    using size_type             = std::size_t;
+
+    column_span(T* data, size_type size) : m_data{ data }, m_size{ size } { }
+
+    auto data() const -> T* { return this->m_data; }
+    auto size() const -> size_type { return this->m_size; }
+    auto empty() const -> bool { return this->m_size == 0; }
+
+    auto operator[](size_type index) const -> T& { return this->m_data[index]; }
+
+    auto begin() const -> T* { return this->m_data; }
+    auto end() const -> T* { return this->m_data + this->m_size; }
+
+private:
+    T* m_data;
+    size_type m_size;
+};
+
+///
+/// Structure of arrays: every field of a row lives in its own contiguous
+/// column so a loop over one field only pulls that field into the cache.
+/// All columns share one size and capacity and grow together through the
+/// growth policy, with the elements moved by the relocation helpers of
+/// kt::vector. The growth policy sees a row, the sum of the field sizes,
+/// as the element size.
+///
+/// Rows are accessed through std::tuple<Ts&...>, so structured bindings
+/// work on operator[] and on the iterators. Use soa_vector<Ts...> for the
+/// default policies or basic_soa_vector<Growth, Errors, Ts...> to choose them
+///
+template <typename Growth, typename Errors, typename... Ts>
+class basic_soa_vector
+{
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    static_assert(((is_trivially_relocatable_v<Ts> or std::is_nothrow_move_constructible_v<Ts>) and ...),
+        "columns are relocated one after the other, which must not throw half way through");
+
+    using columns_type = std::tuple<Ts*...>;
+    using column_indices = std::index_sequence_for<Ts...>;
+
+public:
+    using value_type            = std::tuple<Ts...>;
+    using growth_policy         = Growth;
+    using error_policy          = Errors;
+    using size_type             = std::size_t;
+    using reference_type        = std::tuple<Ts&...>;
+    using const_reference_type  = std::tuple<const Ts&...>;
+
+    template <std::size_t Column>
+    using column_type = std::tuple_element_t<Column, value_type>;
+
+    static constexpr size_type column_count{ sizeof...(Ts) };
+    static constexpr size_type row_size{ (sizeof(Ts) + ...) };
+
+    ///
+    /// Random access iterator over rows. Dereferencing yields a tuple of
+    /// references, a proxy, so algorithms that swap through the iterators
+    /// such as std::sort do not work on it
+    ///
+    template <bool Const>
+    class basic_iterator
+    {
+        using owner_type = std::conditional_t<Const, const basic_soa_vector, basic_soa_vector>;
+
+    public:
+        using iterator_category     = std::random_access_iterator_tag;
+        using value_type            = std::tuple<Ts...>;
+        using difference_type       = std::ptrdiff_t;
+        using reference             = std::conditional_t<Const, const_reference_type, reference_type>;
+        using pointer               = void;
+
+        basic_iterator() = default;
+        basic_iterator(owner_type* owner, size_type index) : m_owner{ owner }, m_index{ index } { }
+
+        // a mutable iterator converts to a constant one
+        template <bool OtherConst, typename = std::enable_if_t<Const and not OtherConst>>
+        basic_iterator(const basic_iterator<OtherConst>& other) : m_owner{ other.m_owner }, m_index{ other.m_index } { }
+
+        auto operator*() const -> reference { return (*this->m_owner)[this->m_index]; }
+        auto operator[](difference_type offset) const -> reference { return (*this->m_owner)[this->m_index + offset]; }
+
+        auto index() const -> size_type { return this->m_index; }
+
+        auto operator++() -> basic_iterator& { ++this->m_index; return *this; }
+        auto operator--() -> basic_iterator& { --this->m_index; return *this; }
+        auto operator++(int) -> basic_iterator { basic_iterator copy{ *this }; ++this->m_index; return copy; }
+        auto operator--(int) -> basic_iterator { basic_iterator copy{ *this }; --this->m_index; return copy; }
+
+        auto operator+=(difference_type offset) -> basic_iterator& { this->m_index += offset; return *this; }
+        auto operator-=(difference_type offset) -> basic_iterator& { this->m_index -= offset; return *this; }
+
+        auto operator+(difference_type offset) const -> basic_iterator { return { this->m_owner, this->m_index + offset }; }
+        auto operator-(difference_type offset) const -> basic_iterator { return { this->m_owner, this->m_index - offset }; }
+
+        auto operator-(const basic_iterator& other) const -> difference_type
+        {
+            return static_cast<difference_type>(this->m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        auto operator==(const basic_iterator& other) const -> bool { return this->m_index == other.m_index; }
+        auto operator!=(const basic_iterator& other) const -> bool { return this->m_index != other.m_index; }
+        auto operator<(const basic_iterator& other) const -> bool { return this->m_index < other.m_index; }
+        auto operator>(const basic_iterator& other) const -> bool { return this->m_index > other.m_index; }
+        auto operator<=(const basic_iterator& other) const -> bool { return this->m_index <= other.m_index; }
+        auto operator>=(const basic_iterator& other) const -> bool { return this->m_index >= other.m_index; }
+
+        friend auto operator+(difference_type offset, const basic_iterator& it) -> basic_iterator { return it + offset; }
+
+    private:
+        template <bool>
+        friend class basic_iterator;
+
+        owner_type* m_owner{};
+        size_type m_index{};
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    ///
+    /// Default constructor
+    ///
+    basic_soa_vector() = default;
+
+    ///
+    /// Construct from a list of rows
+    ///
+    basic_soa_vector(std::initializer_list<value_type> rows)
+    {
+        reserve(rows.size());
+
+        for (const value_type& row : rows)
+            push_back(row);
+    }
+
+    ///
+    /// Copy constructor
+    ///
+    basic_soa_vector(const basic_soa_vector& other)
+    {
+        if (other.m_count == 0 or not allocate_columns(this->m_columns, other.m_count, column_indices{}))
+            return;
+
+        copy_columns(other.m_columns, other.m_count, column_indices{});
+        this->m_count = other.m_count;
+        this->m_capacity = other.m_count;
+    }
+
+    ///
+    /// Move constructor
+    ///
+    basic_soa_vector(basic_soa_vector&& other) noexcept
+        :   m_columns{ std::exchange(other.m_columns, columns_type{}) }
+        ,   m_count{ std::exchange(other.m_count, 0) }
+        ,   m_capacity{ std::exchange(other.m_capacity, 0) }
+    {
+
+    }
+
+    auto operator=(const basic_soa_vector& other) -> basic_soa_vector&
+    {
+        if (this != &other)
+        {
+            basic_soa_vector copy{ other };
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    auto operator=(basic_soa_vector&& other) noexcept -> basic_soa_vector&
+    {
+        if (this != &other)
+        {
+            basic_soa_vector moved{ std::move(other) };
+            swap(moved);
+        }
+
+        return *this;
+    }
+
+    ~basic_soa_vector()
+    {
+        clear();
+        deallocate_columns(this->m_columns, this->m_capacity, column_indices{});
+    }
+
+    auto swap(basic_soa_vector& other) noexcept -> void
+    {
+        std::swap(this->m_columns, other.m_columns);
+        std::swap(this->m_count, other.m_count);
+        std::swap(this->m_capacity, other.m_capacity);
+    }
+
+    ///
+    /// Returns the amount of rows in the vector
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_count;
+    }
+
+    ///
+    /// Returns the amount of rows the columns have room for
+    ///
+    auto capacity() const -> size_type
+    {
+        return this->m_capacity;
+    }
+
+    auto empty() const -> bool
+    {
+        return this->m_count == 0;
+    }
+
+    ///
+    /// Returns the row at "index" as a tuple of references, no bounds checking
+    ///
+    auto operator[](size_type index) -> reference_type
+    {
+        return row(index, column_indices{});
+    }
+
+    auto operator[](size_type index) const -> const_reference_type
+    {
+        return row(index, column_indices{});
+    }
+
+    ///
+    /// Returns the field "Column" of the row at "index"
+    ///
+    template <std::size_t Column>
+    auto get(size_type index) -> column_type<Column>&
+    {
+        return std::get<Column>(this->m_columns)[index];
+    }
+
+    template <std::size_t Column>
+    auto get(size_type index) const -> const column_type<Column>&
+    {
+        return std::get<Column>(this->m_columns)[index];
+    }
+
+    ///
+    /// Returns the contiguous array of the field "Column", for
+    /// instance to hand it to the kernels of simd.h
+    ///
+    template <std::size_t Column>
+    auto column() -> column_span<column_type<Column>>
+    {
+        return { std::get<Column>(this->m_columns), this->m_count };
+    }
+
+    template <std::size_t Column>
+    auto column() const -> column_span<const column_type<Column>>
+    {
+        return { std::get<Column>(this->m_columns), this->m_count };
+    }
+
+    template <std::size_t Column>
+    auto data() -> column_type<Column>*
+    {
+        return std::get<Column>(this->m_columns);
+    }
+
+    template <std::size_t Column>
+    auto data() const -> const column_type<Column>*
+    {
+        return std::get<Column>(this->m_columns);
+    }
+
+    ///
+    /// Make room for at least "count" rows
+    ///
+    auto reserve(size_type count) -> void
+    {
+        if (count > this->m_capacity)
+            reallocate(count);
+    }
+
+    ///
+    /// Adjust the vector to contain "count" rows, new fields are value initialized
+    ///
+    auto resize(size_type count) -> void
+    {
+        if (count <= this->m_count)
+        {
+            remove_n(this->m_count - count);
+            return;
+        }
+
+        if (count > this->m_capacity and not reallocate(Growth::next_capacity(this->m_capacity, count, row_size)))
+            return;
+
+        for (; this->m_count < count; ++this->m_count)
+            construct_row(this->m_columns, this->m_count, column_indices{});
+    }
+
+    ///
+    /// Release the unused capacity of every column
+    ///
+    auto shrink_to_fit() -> void
+    {
+        if (this->m_count != this->m_capacity)
+            reallocate(this->m_count);
+    }
+
+    ///
+    /// Construct a row at the end from one argument per column
+    ///
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        static_assert(sizeof...(Args) == column_count, "emplace_back takes one argument per column");
+
+        if (this->m_count == this->m_capacity)
+        {
+            grow_and_emplace(std::forward<Args>(args)...);
+            return;
+        }
+
+        construct_row(this->m_columns, this->m_count, column_indices{}, std::forward<Args>(args)...);
+        this->m_count += 1;
+    }
+
+    auto push_back(const value_type& row) -> void
+    {
+        std::apply([this](const Ts&... fields) -> void { emplace_back(fields...); }, row);
+    }
+
+    auto push_back(value_type&& row) -> void
+    {
+        std::apply([this](Ts&... fields) -> void { emplace_back(std::move(fields)...); }, row);
+    }
+
+    ///
+    /// Destroy the last "count" rows, or every row if there are fewer
+    ///
+    auto remove_n(size_type count) -> void
+    {
+        if (count > this->m_count)
+            count = this->m_count;
+
+        destroy_rows(this->m_count - count, count, column_indices{});
+        this->m_count -= count;
+    }
+
+    auto pop_back() -> void
+    {
+        remove_n(1);
+    }
+
+    auto clear() -> void
+    {
+        remove_n(this->m_count);
+    }
+
+    auto begin() -> iterator { return { this, 0 }; }
+    auto end() -> iterator { return { this, this->m_count }; }
+    auto begin() const -> const_iterator { return { this, 0 }; }
+    auto end() const -> const_iterator { return { this, this->m_count }; }
+    auto cbegin() const -> const_iterator { return begin(); }
+    auto cend() const -> const_iterator { return end(); }
+
+private:
+    template <std::size_t... Column>
+    auto row(size_type index, std::index_sequence<Column...>) -> reference_type
+    {
+        return { std::get<Column>(this->m_columns)[index]... };
+    }
+
+    template <std::size_t... Column>
+    auto row(size_type index, std::index_sequence<Column...>) const -> const_reference_type
+    {
+        return { std::get<Column>(this->m_columns)[index]... };
+    }
+
+    ///
+    /// Allocate a block of "count" fields for every column of "blocks".
+    /// If one allocation fails the others are released, the error policy is
+    /// told and false is returned
+    ///
+    template <std::size_t... Column>
+    static auto allocate_columns(columns_type& blocks, size_type count, std::index_sequence<Column...>) -> bool
+    {
+        const bool allocated{ (allocate_column(std::get<Column>(blocks), count) and ...) };
+
+        if (not allocated)
+        {
+            deallocate_columns(blocks, count, column_indices{});
+            Errors::on_allocation_failure("could not allocate block of memory...");
+        }
+
+        return allocated;
+    }
+
+    template <typename T>
+    static auto allocate_column(T*& block, size_type count) -> bool
+    {
+        try
+        {
+            std::allocator<T> alloc{};
+            block = alloc.allocate(count);
+
+            return true;
+        }
+        catch (const std::bad_alloc&)
+        {
+            block = nullptr;
+            return false;
+        }
+    }
+
+    template <std::size_t... Column>
+    static auto deallocate_columns(columns_type& blocks, size_type count, std::index_sequence<Column...>) -> void
+    {
+        (deallocate_column(std::get<Column>(blocks), count), ...);
+    }
+
+    template <typename T>
+    static auto deallocate_column(T*& block, size_type count) -> void
+    {
+        if (block)
+        {
+            std::allocator<T> alloc{};
+            alloc.deallocate(block, count);
+        }
+
+        block = nullptr;
+    }
+
+    ///
+    /// Construct the fields of row "index" in "blocks" from "args", or value
+    /// initialize them if there are none. If one of the constructors throws,
+    /// the fields already built are destroyed and the exception is propagated
+    ///
+    template <std::size_t... Column, typename... Args>
+    static auto construct_row(columns_type& blocks, size_type index, std::index_sequence<Column...>, Args&&... args) -> void
+    {
+        size_type constructed{};
+
+        try
+        {
+            if constexpr (sizeof...(Args) == 0)
+                ((::new (static_cast<void*>(std::get<Column>(blocks) + index)) column_type<Column>(), ++constructed), ...);
+            else
+                ((::new (static_cast<void*>(std::get<Column>(blocks) + index)) column_type<Column>(std::forward<Args>(args)),
+                    ++constructed), ...);
+        }
+        catch (...)
+        {
+            ((Column < constructed ? std::destroy_at(std::get<Column>(blocks) + index) : void()), ...);
+            throw;
+        }
+    }
+
+    // copy every column of "source" into the freshly allocated columns of this vector
+    template <std::size_t... Column>
+    auto copy_columns(const columns_type& source, size_type count, std::index_sequence<Column...>) -> void
+    {
+        size_type copied{};
+
+        try
+        {
+            ((copy_column(std::get<Column>(source), count, std::get<Column>(this->m_columns)), ++copied), ...);
+        }
+        catch (...)
+        {
+            ((Column < copied ? destroy_column(std::get<Column>(this->m_columns), 0, count) : void()), ...);
+            deallocate_columns(this->m_columns, count, column_indices{});
+            throw;
+        }
+    }
+
+    template <typename T>
+    static auto copy_column(const T* source, size_type count, T* dest) -> void
+    {
+        std::allocator<T> alloc{};
+        uninitialized_copy_n(alloc, source, count, dest);
+    }
+
+    template <typename T>
+    static auto destroy_column(T* block, size_type first, size_type count) -> void
+    {
+        std::allocator<T> alloc{};
+        destroy_n(alloc, block + first, count);
+    }
+
+    template <std::size_t... Column>
+    auto destroy_rows(size_type first, size_type count, std::index_sequence<Column...>) -> void
+    {
+        (destroy_column(std::get<Column>(this->m_columns), first, count), ...);
+    }
+
+    template <typename T>
+    static auto relocate_column(T* source, size_type count, T* dest) -> void
+    {
+        std::allocator<T> alloc{};
+        relocate_n(alloc, source, count, dest);
+    }
+
+    template <std::size_t... Column>
+    static auto relocate_columns(columns_type& source, size_type count, columns_type& dest,
+        std::index_sequence<Column...>) -> void
+    {
+        (relocate_column(std::get<Column>(source), count, std::get<Column>(dest)), ...);
+    }
+
+    ///
+    /// Move every column to blocks of "new_capacity" rows
+    ///
+    auto reallocate(size_type new_capacity) -> bool
+    {
+        columns_type blocks{};
+
+        if (new_capacity != 0 and not allocate_columns(blocks, new_capacity, column_indices{}))
+            return false;
+
+        relocate_columns(this->m_columns, this->m_count, blocks, column_indices{});
+        deallocate_columns(this->m_columns, this->m_capacity, column_indices{});
+
+        this->m_columns = blocks;
+        this->m_capacity = new_capacity;
+
+        return true;
+    }
+
+    ///
+    /// Build the new row in bigger blocks before relocating the old rows,
+    /// so arguments referring to fields of this vector stay valid
+    ///
+    template <typename... Args>
+    auto grow_and_emplace(Args&&... args) -> void
+    {
+        const size_type new_capacity{ Growth::next_capacity(this->m_capacity, this->m_count + 1, row_size) };
+        columns_type blocks{};
+
+        if (not allocate_columns(blocks, new_capacity, column_indices{}))
+            return;
+
+        try
+        {
+            construct_row(blocks, this->m_count, column_indices{}, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate_columns(blocks, new_capacity, column_indices{});
+            throw;
+        }
+
+        relocate_columns(this->m_columns, this->m_count, blocks, column_indices{});
+        deallocate_columns(this->m_columns, this->m_capacity, column_indices{});
+
+        this->m_columns = blocks;
+        this->m_capacity = new_capacity;
+        this->m_count += 1;
+    }
+
+    columns_type m_columns{};
+    size_type m_count{};
+    size_type m_capacity{};
+};
+
+template <typename... Ts>
+using soa_vector = basic_soa_vector<grow_double, errors_throw, Ts...>;
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,570 @@
+#ifndef STABLE_VECTOR_HH
+#define STABLE_VECTOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <initializer_list>
+
+#include "relocation.h"
+#include "error_policy.h"
+#include "growth_policy.h"
+#include "segment_math.h"
+
+namespace kt
+{
+///
+/// Vector whose elements never move. They live in segments that are
+/// allocated as the vector grows and only released by shrink_to_fit or
+/// the destructor: segment 0 holds first_segment_size elements and every
+/// following segment twice as many as the one before, so an index is
+/// turned into a segment and an offset with a single count-leading-zeros.
+///
+/// Growing never copies the existing elements, so the peak memory of an
+/// append is the used memory plus one segment, every append costs about
+/// the same, and references, pointers and iterators stay valid until the
+/// element they refer to is removed. Iterators also read the segment
+/// table of the vector, moving or swapping the vector invalidates them.
+/// The price is that the elements are not one contiguous block, there is
+/// no data()
+///
+template <typename T, typename Alloc = std::allocator<T>, typename Errors = errors_throw>
+class stable_vector
+{
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+public:
+    using value_type            = T;
+    using allocator_type        = Alloc;
+    using error_policy          = Errors;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    ///
+    /// Elements in segment 0, the smallest power of two covering a cache line worth of them
+    ///
+    static constexpr size_type first_segment_size{ detail::segment_math<T>::first_segment_size };
+
+    ///
+    /// Random access iterator that walks a segment with a plain pointer and
+    /// only looks at the segment table when it crosses into another one.
+    /// Jumps locate their segment like operator[] does
+    ///
+    template <bool Const>
+    class basic_iterator
+    {
+        using segments_type = std::conditional_t<Const, const T* const*, T* const*>;
+
+    public:
+        using iterator_category     = std::random_access_iterator_tag;
+        using value_type            = T;
+        using difference_type       = std::ptrdiff_t;
+        using reference             = std::conditional_t<Const, const T&, T&>;
+        using pointer               = std::conditional_t<Const, const T*, T*>;
+
+        basic_iterator() = default;
+
+        basic_iterator(segments_type segments, size_type index)
+            :   m_segments{ segments }
+            ,   m_index{ index }
+        {
+            const auto [segment, offset]{ segments::locate(index) };
+
+            this->m_segment = segment;
+            this->m_current = segments[segment] ? segments[segment] + offset : nullptr;
+        }
+
+        // a mutable iterator converts to a constant one
+        template <bool OtherConst, typename = std::enable_if_t<Const and not OtherConst>>
+        basic_iterator(const basic_iterator<OtherConst>& other)
+            :   m_segments{ other.m_segments }
+            ,   m_current{ other.m_current }
+            ,   m_segment{ other.m_segment }
+            ,   m_index{ other.m_index }
+        {
+
+        }
+
+        auto operator*() const -> reference { return *this->m_current; }
+        auto operator->() const -> pointer { return this->m_current; }
+        auto operator[](difference_type offset) const -> reference { return *(*this + offset); }
+
+        auto index() const -> size_type { return this->m_index; }
+
+        auto operator++() -> basic_iterator&
+        {
+            ++this->m_index;
+            ++this->m_current;
+
+            if (this->m_current == this->m_segments[this->m_segment] + segments::segment_size(this->m_segment))
+            {
+                ++this->m_segment;
+                this->m_current = this->m_segments[this->m_segment];
+            }
+
+            return *this;
+        }
+
+        auto operator--() -> basic_iterator&
+        {
+            if (this->m_current == this->m_segments[this->m_segment])
+            {
+                --this->m_segment;
+                this->m_current = this->m_segments[this->m_segment] + segments::segment_size(this->m_segment);
+            }
+
+            --this->m_index;
+            --this->m_current;
+
+            return *this;
+        }
+
+        auto operator++(int) -> basic_iterator { basic_iterator copy{ *this }; ++*this; return copy; }
+        auto operator--(int) -> basic_iterator { basic_iterator copy{ *this }; --*this; return copy; }
+
+        auto operator+=(difference_type offset) -> basic_iterator& { return *this = *this + offset; }
+        auto operator-=(difference_type offset) -> basic_iterator& { return *this = *this - offset; }
+
+        auto operator+(difference_type offset) const -> basic_iterator { return { this->m_segments, this->m_index + offset }; }
+        auto operator-(difference_type offset) const -> basic_iterator { return { this->m_segments, this->m_index - offset }; }
+
+        auto operator-(const basic_iterator& other) const -> difference_type
+        {
+            return static_cast<difference_type>(this->m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        auto operator==(const basic_iterator& other) const -> bool { return this->m_index == other.m_index; }
+        auto operator!=(const basic_iterator& other) const -> bool { return this->m_index != other.m_index; }
+        auto operator<(const basic_iterator& other) const -> bool { return this->m_index < other.m_index; }
+        auto operator>(const basic_iterator& other) const -> bool { return this->m_index > other.m_index; }
+        auto operator<=(const basic_iterator& other) const -> bool { return this->m_index <= other.m_index; }
+        auto operator>=(const basic_iterator& other) const -> bool { return this->m_index >= other.m_index; }
+
+        friend auto operator+(difference_type offset, const basic_iterator& it) -> basic_iterator { return it + offset; }
+
+    private:
+        template <bool>
+        friend class basic_iterator;
+
+        segments_type m_segments{};
+        pointer m_current{};
+        size_type m_segment{};
+        size_type m_index{};
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    ///
+    /// Default constructor
+    ///
+    stable_vector() = default;
+
+    explicit stable_vector(const allocator_type& alloc)
+        :   m_alloc{ alloc }
+    {
+
+    }
+
+    ///
+    /// Construct a vector of "count" value initialized elements
+    ///
+    stable_vector(size_type count, const allocator_type& alloc = allocator_type())
+        :   m_alloc{ alloc }
+    {
+        resize(count);
+    }
+
+    stable_vector(std::initializer_list<T> content, const allocator_type& alloc = allocator_type())
+        :   m_alloc{ alloc }
+    {
+        reserve(content.size());
+
+        for (const_reference_type value : content)
+            push_back(value);
+    }
+
+    ///
+    /// Copy constructor. Copies segment by segment, the copy has the same layout
+    ///
+    stable_vector(const stable_vector& other)
+        :   m_alloc{ alloc_traits::select_on_container_copy_construction(other.m_alloc) }
+    {
+        try
+        {
+            copy_elements_from(other);
+        }
+        catch (...)
+        {
+            release_segments(0);
+            throw;
+        }
+    }
+
+    ///
+    /// Move constructor. Takes the segments of "other", which is left empty
+    ///
+    stable_vector(stable_vector&& other) noexcept
+        :   m_alloc{ std::move(other.m_alloc) }
+    {
+        steal(other);
+    }
+
+    ///
+    /// Assigment operator. Deep copy of "other" into the segments this vector
+    /// already has, the allocator is replaced only if it propagates on copy
+    /// assignment
+    ///
+    auto operator=(const stable_vector& other) -> stable_vector&
+    {
+        if (this != &other)
+        {
+            clear();
+
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                // the segments have to go back to the allocator that handed them out
+                if (this->m_alloc != other.m_alloc)
+                    release_segments(0);
+
+                this->m_alloc = other.m_alloc;
+            }
+
+            copy_elements_from(other);
+        }
+
+        return *this;
+    }
+
+    ///
+    /// Assigment operator. The segments of "other" are taken over when the
+    /// allocators allow it, otherwise elements are moved one by one
+    ///
+    auto operator=(stable_vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value
+        or alloc_traits::is_always_equal::value) -> stable_vector&
+    {
+        if (this != &other)
+        {
+            clear();
+
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                release_segments(0);
+                this->m_alloc = std::move(other.m_alloc);
+                steal(other);
+            }
+            else
+            {
+                if (this->m_alloc == other.m_alloc)
+                {
+                    release_segments(0);
+                    steal(other);
+                }
+                else
+                    move_elements_from(other);
+            }
+        }
+
+        return *this;
+    }
+
+    ~stable_vector()
+    {
+        clear();
+        release_segments(0);
+    }
+
+    ///
+    /// Exchange the contents of this vector and "other". Allocators are
+    /// swapped only if they propagate on swap, otherwise they must compare equal
+    ///
+    auto swap(stable_vector& other) noexcept -> void
+    {
+        using std::swap;
+
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+            swap(this->m_alloc, other.m_alloc);
+        swap(this->m_segments, other.m_segments);
+        swap(this->m_count, other.m_count);
+        swap(this->m_capacity, other.m_capacity);
+        swap(this->m_segment_count, other.m_segment_count);
+    }
+
+    auto get_allocator() const -> allocator_type
+    {
+        return this->m_alloc;
+    }
+
+    ///
+    /// Returns the amount of elements in the vector
+    ///
+    auto size() const -> size_type
+    {
+        return this->m_count;
+    }
+
+    ///
+    /// Returns the amount of elements the allocated segments have room for
+    ///
+    auto capacity() const -> size_type
+    {
+        return this->m_capacity;
+    }
+
+    auto empty() const -> bool
+    {
+        return this->m_count == 0;
+    }
+
+    ///
+    /// Returns the element at "index", no bounds checking
+    ///
+    auto operator[](size_type index) -> reference_type
+    {
+        const auto [segment, offset]{ segments::locate(index) };
+        return this->m_segments[segment][offset];
+    }
+
+    auto operator[](size_type index) const -> const_reference_type
+    {
+        const auto [segment, offset]{ segments::locate(index) };
+        return this->m_segments[segment][offset];
+    }
+
+    ///
+    /// Allocate the segments needed to hold "count" elements
+    ///
+    auto reserve(size_type count) -> void
+    {
+        while (this->m_capacity < count)
+            if (not add_segment())
+                return;
+    }
+
+    ///
+    /// Adjust the vector to contain "count" elements, new ones are value initialized
+    ///
+    auto resize(size_type count) -> void
+    {
+        if (count <= this->m_count)
+        {
+            remove_n(this->m_count - count);
+            return;
+        }
+
+        reserve(count);
+
+        while (this->m_count < count and this->m_count < this->m_capacity)
+            emplace_back();
+    }
+
+    auto resize(size_type count, const_reference_type value) -> void
+    {
+        if (count <= this->m_count)
+        {
+            remove_n(this->m_count - count);
+            return;
+        }
+
+        reserve(count);
+
+        while (this->m_count < count and this->m_count < this->m_capacity)
+            emplace_back(value);
+    }
+
+    ///
+    /// Release the segments no element lives in
+    ///
+    auto shrink_to_fit() -> void
+    {
+        release_segments(this->m_count == 0 ? 0 : segments::locate(this->m_count - 1).first + 1);
+    }
+
+    ///
+    /// Insert elements at the end. Never moves the elements already in the vector
+    ///
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        // add_segment() has reported the failure to the error policy
+        if (this->m_count == this->m_capacity and not add_segment())
+            return;
+
+        const auto [segment, offset]{ segments::locate(this->m_count) };
+
+        alloc_traits::construct(this->m_alloc, this->m_segments[segment] + offset, std::forward<Args>(args)...);
+        this->m_count += 1;
+    }
+
+    auto push_back(const_reference_type info) -> void
+    {
+        emplace_back(info);
+    }
+
+    auto push_back(T&& info) -> void
+    {
+        emplace_back(std::move(info));
+    }
+
+    ///
+    /// Destroy the last n elements. If there is less than
+    /// count elements, it empties the vector
+    ///
+    auto remove_n(size_type count) -> void
+    {
+        if (count > this->m_count)
+            count = this->m_count;
+
+        for (; count != 0; --count)
+            pop_back();
+    }
+
+    ///
+    /// Remove the last element from the vector
+    ///
+    auto pop_back() -> void
+    {
+        if (this->m_count != 0)
+        {
+            this->m_count -= 1;
+            alloc_traits::destroy(this->m_alloc, &(*this)[this->m_count]);
+        }
+    }
+
+    ///
+    /// Remove all elements from the vector, the segments are kept for reuse
+    ///
+    auto clear() -> void
+    {
+        size_type remaining{ this->m_count };
+
+        for (size_type segment{}; remaining != 0; ++segment)
+        {
+            const size_type count{ std::min(segments::segment_size(segment), remaining) };
+
+            destroy_n(this->m_alloc, this->m_segments[segment], count);
+            remaining -= count;
+        }
+
+        this->m_count = 0;
+    }
+
+    auto begin() -> iterator { return iterator{ this->m_segments, 0 }; }
+    auto end() -> iterator { return iterator{ this->m_segments, this->m_count }; }
+    auto begin() const -> const_iterator { return const_iterator{ this->m_segments, 0 }; }
+    auto end() const -> const_iterator { return const_iterator{ this->m_segments, this->m_count }; }
+    auto cbegin() const -> const_iterator { return begin(); }
+    auto cend() const -> const_iterator { return end(); }
+
+private:
+    using segments = detail::segment_math<T>;
+
+    // one spare null entry so iterators can step onto the segment after the last one
+    static constexpr size_type segment_count{ segments::max_segments + 1 };
+
+    ///
+    /// Allocate the next segment, doubling the capacity. A failure goes to the error policy
+    ///
+    auto add_segment() -> bool
+    {
+        const size_type segment{ this->m_segment_count };
+
+        try
+        {
+            this->m_segments[segment] = alloc_traits::allocate(this->m_alloc, segments::segment_size(segment));
+        }
+        catch (const std::bad_alloc&)
+        {
+            Errors::on_allocation_failure("could not allocate a segment...");
+            return false;
+        }
+
+        this->m_capacity += segments::segment_size(segment);
+        this->m_segment_count += 1;
+
+        return true;
+    }
+
+    ///
+    /// Free every segment from "first" on, which must not hold elements
+    ///
+    auto release_segments(size_type first) -> void
+    {
+        while (this->m_segment_count > first)
+        {
+            const size_type segment{ --this->m_segment_count };
+
+            alloc_traits::deallocate(this->m_alloc, this->m_segments[segment], segments::segment_size(segment));
+            this->m_segments[segment] = nullptr;
+            this->m_capacity -= segments::segment_size(segment);
+        }
+    }
+
+    ///
+    /// Copy the elements of "other" into this empty vector, segment by segment so
+    /// the copy has the same layout. If a copy throws the vector is left empty
+    ///
+    auto copy_elements_from(const stable_vector& other) -> void
+    {
+        reserve(other.m_count);
+
+        if (this->m_capacity < other.m_count)
+            return;
+
+        try
+        {
+            for (size_type segment{}; this->m_count < other.m_count; ++segment)
+            {
+                const size_type count{ std::min(segments::segment_size(segment), other.m_count - this->m_count) };
+
+                uninitialized_copy_n(this->m_alloc, static_cast<const T*>(other.m_segments[segment]), count,
+                    this->m_segments[segment]);
+                this->m_count += count;
+            }
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    // take over the segments of "other", leaving it empty. This vector must own no segment
+    auto steal(stable_vector& other) noexcept -> void
+    {
+        this->m_count = std::exchange(other.m_count, 0);
+        this->m_capacity = std::exchange(other.m_capacity, 0);
+        this->m_segment_count = std::exchange(other.m_segment_count, 0);
+
+        for (size_type segment{}; segment < segment_count; ++segment)
+            this->m_segments[segment] = std::exchange(other.m_segments[segment], nullptr);
+    }
+
+    // used when the allocators differ and the segments of "other" can not be adopted
+    auto move_elements_from(stable_vector& other) -> void
+    {
+        reserve(other.m_count);
+
+        while (this->m_count < other.m_count and this->m_count < this->m_capacity)
+            emplace_back(std::move(other[this->m_count]));
+
+        other.clear();
+    }
+
+    Alloc m_alloc{};
+    T* m_segments[segment_count]{};
+    size_type m_count{};
+    size_type m_capacity{};
+    size_type m_segment_count{};
+};
+
+}   // END KT NAMESPACE
+
+#endif
@@ -0,0 +1,438 @@
+#ifndef STATIC_VECTOR_HH
+#define STATIC_VECTOR_HH
+
+// C++ standard library includes
+#include <new>
+#include <cstdio>
+#include <memory>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+#include <exception>
+#include <string_view>
+#include <type_traits>
+#include <initializer_list>
+
+#include "vector.h"
+#include "relocation.h"
+
+namespace kt
+{
+///
+/// Thrown by static_vector with the overflow_throw policy
+///
+class capacity_exceeded : public std::exception
+{
+public:
+    capacity_exceeded() = default;
+    ~capacity_exceeded() = default;
+
+    const char* what() const noexcept override
+    {
+        return this->m_exc.data();
+    }
+
+private:
+    std::string_view m_exc{ "[capacity_exceeded]: static_vector is full\n" };
+};
+
+///
+/// Overflow policies of static_vector, picking what happens when an element
+/// is added to a full vector. on_overflow() returns what the insertion returns
+///
+
+/// The insertion does nothing and returns false
+struct overflow_return_false
+{
+    static constexpr auto on_overflow() noexcept -> bool
+    {
+        return false;
+    }
+};
+
+/// The program is aborted, for code where running out of room is a bug
+struct overflow_abort
+{
+    [[noreturn]] static auto on_overflow() noexcept -> bool
+    {
+        std::fputs("[capacity_exceeded]: static_vector is full, aborting\n", stderr);
+        std::abort();
+    }
+};
+
+/// A kt::capacity_exceeded exception is thrown
+struct overflow_throw
+{
+    [[noreturn]] static auto on_overflow() -> bool
+    {
+        throw capacity_exceeded{};
+    }
+};
+
+namespace detail
+{
+    ///
+    /// Storage of static_vector for trivial types: a plain array, so the
+    /// vector keeps trivial copies and destructor and is usable in constant
+    /// expressions. C++17 needs every slot initialized for that, so the
+    /// constructor zeroes the whole array
+    ///
+    template <typename T, std::size_t N, bool = std::is_trivial_v<T>>
+    class static_storage
+    {
+    protected:
+        constexpr auto slots() noexcept -> T* { return this->m_elements; }
+        constexpr auto slots() const noexcept -> const T* { return this->m_elements; }
+
+        template <typename... Args>
+        constexpr auto construct(std::size_t index, Args&&... args) -> void
+        {
+            this->m_elements[index] = T(std::forward<Args>(args)...);
+        }
+
+        constexpr auto destroy(std::size_t, std::size_t) noexcept -> void
+        {
+
+        }
+
+        T m_elements[N]{};
+        std::size_t m_count{};
+    };
+
+    ///
+    /// Storage of static_vector for every other type: raw bytes the
+    /// elements are constructed into, only the live ones are copied
+    ///
+    template <typename T, std::size_t N>
+    class static_storage<T, N, false>
+    {
+    protected:
+        static_storage() noexcept
+        {
+
+        }
+
+        static_storage(const static_storage& other)
+        {
+            uninitialized_copy_n(this->m_alloc, other.slots(), other.m_count, slots());
+            this->m_count = other.m_count;
+        }
+
+        // the elements of "other" are moved over and "other" is left empty
+        static_storage(static_storage&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            relocate_n(this->m_alloc, other.slots(), other.m_count, slots());
+            this->m_count = other.m_count;
+            other.m_count = 0;
+        }
+
+        auto operator=(const static_storage& other) -> static_storage&
+        {
+            if (this != &other)
+            {
+                destroy(0, this->m_count);
+                uninitialized_copy_n(this->m_alloc, other.slots(), other.m_count, slots());
+                this->m_count = other.m_count;
+            }
+
+            return *this;
+        }
+
+        auto operator=(static_storage&& other) noexcept(std::is_nothrow_move_constructible_v<T>) -> static_storage&
+        {
+            if (this != &other)
+            {
+                destroy(0, this->m_count);
+                relocate_n(this->m_alloc, other.slots(), other.m_count, slots());
+                this->m_count = other.m_count;
+                other.m_count = 0;
+            }
+
+            return *this;
+        }
+
+        ~static_storage()
+        {
+            destroy(0, this->m_count);
+        }
+
+        auto slots() noexcept -> T* { return std::launder(reinterpret_cast<T*>(this->m_bytes)); }
+        auto slots() const noexcept -> const T* { return std::launder(reinterpret_cast<const T*>(this->m_bytes)); }
+
+        template <typename... Args>
+        auto construct(std::size_t index, Args&&... args) -> void
+        {
+            ::new (static_cast<void*>(slots() + index)) T(std::forward<Args>(args)...);
+        }
+
+        // destroy the elements in [first, last)
+        auto destroy(std::size_t first, std::size_t last) noexcept -> void
+        {
+            destroy_n(this->m_alloc, slots() + first, last - first);
+        }
+
+        // only used to reach the kt relocation helpers, std::allocator has no state
+        std::allocator<T> m_alloc{};
+        alignas(T) std::byte m_bytes[sizeof(T) * N];
+        std::size_t m_count{};
+    };
+}   // END KT::DETAIL NAMESPACE
+
+///
+/// Vector with room for N elements inside the object and no heap at all,
+/// for code that must not allocate such as real-time threads. Adding an
+/// element to a full vector is handled by the "Overflow" policy:
+/// overflow_return_false (the default), overflow_abort or overflow_throw.
+/// Insertions return true when the element was added.
+///
+/// For trivial T the vector is a literal type and every member except the
+/// iterators is constexpr, so tables can be built at compile time:
+///
+///     constexpr auto squares{ []() { kt::static_vector<int, 8> table{};
+///                                    for (int i{}; i < 8; ++i) table.push_back(i * i);
+///                                    return table; }() };
+///     static_assert(squares[3] == 9);
+///
+/// Overflowing during constant evaluation with overflow_abort or
+/// overflow_throw fails to compile
+///
+template <typename T, std::size_t N, typename Overflow = overflow_return_false>
+class static_vector : private detail::static_storage<T, N>
+{
+    static_assert(N > 0, "static_vector needs room for at least one element");
+
+    using storage = detail::static_storage<T, N>;
+
+public:
+    using value_type            = T;
+    using overflow_policy       = Overflow;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    // same iterators as kt::vector so the containers can be used interchangeably
+    using iterator              = typename vector<T>::iterator;
+    using const_iterator        = typename vector<T>::const_iterator;
+
+    static constexpr size_type static_capacity{ N };
+
+    ///
+    /// Default constructor
+    ///
+    constexpr static_vector() = default;
+
+    ///
+    /// Parametrized constructor. Initializes vector with the elements from
+    /// "content", the ones past the capacity go through the overflow policy
+    ///
+    constexpr static_vector(std::initializer_list<T> content)
+        :   storage{}
+    {
+        for (const T& element : content)
+            if (not push_back(element))
+                break;
+    }
+
+    ///
+    /// Amount of elements in the vector
+    ///
+    constexpr auto size() const -> size_type
+    {
+        return this->m_count;
+    }
+
+    ///
+    /// Maximum amount of elements, always N
+    ///
+    constexpr auto capacity() const -> size_type
+    {
+        return N;
+    }
+
+    ///
+    /// Return true if this vector has no elements, false otherwise
+    ///
+    constexpr auto empty() const -> bool
+    {
+        return this->m_count == 0;
+    }
+
+    ///
+    /// Return true if no more elements fit
+    ///
+    constexpr auto full() const -> bool
+    {
+        return this->m_count == N;
+    }
+
+    ///
+    /// Returns reference to element at postion "index"
+    ///
+    constexpr auto operator[](size_type index) -> reference_type
+    {
+        return this->slots()[index];
+    }
+
+    ///
+    /// Returns constant reference to element at postion "index"
+    ///
+    constexpr auto operator[](size_type index) const -> const_reference_type
+    {
+        return this->slots()[index];
+    }
+
+    constexpr auto data() -> pointer_type
+    {
+        return this->slots();
+    }
+
+    constexpr auto data() const -> const T*
+    {
+        return this->slots();
+    }
+
+    ///
+    /// Insert elements at the end. Returns false if the vector was full
+    /// and the overflow policy returned
+    ///
+    template <typename... Args>
+    constexpr auto emplace_back(Args&&... args) -> bool
+    {
+        if (this->m_count == N)
+            return Overflow::on_overflow();
+
+        this->construct(this->m_count, std::forward<Args>(args)...);
+        this->m_count += 1;
+
+        return true;
+    }
+
+    ///
+    /// Insert one element at the end of the vector
+    ///
+    constexpr auto push_back(const_reference_type info) -> bool
+    {
+        return emplace_back(info);
+    }
+
+    ///
+    /// Insert one element at the end of the vector
+    /// with support for move semantics
+    ///
+    constexpr auto push_back(T&& info) -> bool
+    {
+        return emplace_back(std::move(info));
+    }
+
+    ///
+    /// Adjust vector to contain count elements. New elements are value
+    /// initialized, a count past the capacity goes through the overflow policy
+    ///
+    constexpr auto resize(size_type count) -> bool
+    {
+        if (count > N)
+            return Overflow::on_overflow();
+
+        if (count <= this->m_count)
+        {
+            remove_n(this->m_count - count);
+            return true;
+        }
+
+        for (; this->m_count < count; ++this->m_count)
+            this->construct(this->m_count);
+
+        return true;
+    }
+
+    ///
+    /// Destroy the last n elements. If there is less than
+    /// count elements, it empties the vector
+    ///
+    constexpr auto remove_n(size_type count) -> void
+    {
+        if (count > this->m_count)
+            count = this->m_count;
+
+        this->destroy(this->m_count - count, this->m_count);
+        this->m_count -= count;
+    }
+
+    ///
+    /// Remove the last element from the vector
+    ///
+    constexpr auto pop_back() -> void
+    {
+        if (this->m_count != 0)
+        {
+            this->destroy(this->m_count - 1, this->m_count);
+            this->m_count -= 1;
+        }
+    }
+
+    ///
+    /// Remove all elements from the vector
+    ///
+    constexpr auto clear() -> void
+    {
+        this->destroy(0, this->m_count);
+        this->m_count = 0;
+    }
+
+    ///
+    /// Returns an iterator to the beginning of the vector
+    ///
+    auto begin() -> iterator
+    {
+        return iterator{ data() };
+    }
+
+    ///
+    /// Returns an iterator to the element past of the vector
+    ///
+    auto end() -> iterator
+    {
+        return iterator{ data() + this->m_count };
+    }
+
+    ///
+    /// Returns a constant iterator to the beginning of the vector
+    ///
+    auto begin() const -> const_iterator
+    {
+        return const_iterator{ data() };
+    }
+
+    ///
+    /// Returns a constant iterator past the last element of the vector
+    ///
+    auto end() const -> const_iterator
+    {
+        return const_iterator{ data() + this->m_count };
+    }
+
+    ///
+    /// Returns a constant iterator to the beginning of the vector
+    ///
+    auto cbegin() const -> const_iterator
+    {
+        return begin();
+    }
+
+    ///
+    /// Returns a constant iterator past the last element of the vector
+    ///
+    auto cend() const -> const_iterator
+    {
+        return end();
+    }
+
+    // CONSTRAINTS:
+    // N >= m_count >= 0
+    // the slots past m_count hold no live element
+};
+
+}   // END KT NAMESPACE
+
+#endif
@@ -3,38 +3,60 @@
 
 // C++ standard library includes
 #include <new>
-#include <cstdio>
 #include <memory>
 #include <cstring>
 #include <cstdint>
 #include <utility>
 #include <iterator>
 #include <algorithm>
-#include <exception>
-#include <string_view>
+#include <type_traits>
 #include <initializer_list>
 
+#include "relocation.h"
+#include "error_policy.h"
+#include "growth_policy.h"
+#include "instrumentation.h"
+
 #define DEBUG_LOG(log_str)  std::cerr << log_str << '\n'
 
 namespace kt
 {
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = grow_double, typename Errors = errors_throw>
 class vector
 {
+    using alloc_traits = std::allocator_traits<Alloc>;
+
 public:
     using value_type            = T;
+    using allocator_type        = Alloc;
+    using growth_policy         = Growth;
+    using error_policy          = Errors;
     using size_type             = std::size_t;
     using reference_type        = T&;
     using pointer_type          = T*;
     using const_reference_type  = const T&;
 
+    ///
+    /// Random access iterator over the elements, a thin wrapper of a pointer.
+    /// Contiguous, so the standard algorithms take their fastest paths
+    ///
     class iterator
     {
     public:
+        using iterator_category     = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+        using iterator_concept      = std::contiguous_iterator_tag;
+#endif
+        using value_type            = T;
+        using difference_type       = std::ptrdiff_t;
+        using pointer               = T*;
+        using reference             = T&;
+
+        iterator() = default;
         explicit iterator(pointer_type ptr) : p{ ptr } { }
 
         // prefix increment
-        auto operator++() -> iterator
+        auto operator++() -> iterator&
         {
             ++p;
             return *this;
@@ -48,14 +70,14 @@ public:
             return iterator{ res };
         }
 
-        // prefix increment
-        auto operator--() -> iterator
+        // prefix decrement
+        auto operator--() -> iterator&
         {
             --p;
             return *this;
         }
 
-        // postfix increment
+        // postfix decrement
         auto operator--(int) -> iterator
         {
             auto res{ p };
@@ -63,28 +85,48 @@ public:
             return iterator{ res };
         }
 
-        auto operator+(size_type count) -> iterator
+        auto operator+=(difference_type count) -> iterator&
+        {
+            this->p += count;
+            return *this;
+        }
+
+        auto operator-=(difference_type count) -> iterator&
+        {
+            this->p -= count;
+            return *this;
+        }
+
+        auto operator+(difference_type count) const -> iterator
         {
             return iterator{ this->p + count };
         }
 
-        auto operator-(size_type count) -> iterator
+        auto operator-(difference_type count) const -> iterator
         {
             return iterator{ this->p - count };
         }
 
-        auto operator!=(const iterator& other) -> bool
+        friend auto operator+(difference_type count, const iterator& it) -> iterator
         {
-            return this->p != other.p;
+            return iterator{ it.p + count };
         }
 
-        auto operator==(const iterator& other) -> bool
+        friend auto operator-(const iterator& lhs, const iterator& rhs) -> difference_type
         {
-            return this->p == other.p;
+            return lhs.p - rhs.p;
         }
 
-        auto operator*() -> reference_type { return *p; }
-        auto operator->() -> pointer_type { return p; }
+        friend auto operator==(const iterator& lhs, const iterator& rhs) -> bool { return lhs.p == rhs.p; }
+        friend auto operator!=(const iterator& lhs, const iterator& rhs) -> bool { return lhs.p != rhs.p; }
+        friend auto operator<(const iterator& lhs, const iterator& rhs) -> bool { return lhs.p < rhs.p; }
+        friend auto operator>(const iterator& lhs, const iterator& rhs) -> bool { return lhs.p > rhs.p; }
+        friend auto operator<=(const iterator& lhs, const iterator& rhs) -> bool { return lhs.p <= rhs.p; }
+        friend auto operator>=(const iterator& lhs, const iterator& rhs) -> bool { return lhs.p >= rhs.p; }
+
+        auto operator*() const -> reference_type { return *p; }
+        auto operator->() const -> pointer_type { return p; }
+        auto operator[](difference_type index) const -> reference_type { return p[index]; }
 
         auto raw() const -> pointer_type { return p; }
 
@@ -92,13 +134,27 @@ public:
         pointer_type p{};
     };
 
+    ///
+    /// Random access iterator over constant elements. An iterator converts to it
+    ///
     class const_iterator
     {
     public:
-        explicit const_iterator(pointer_type ptr) : p{ ptr } { }
+        using iterator_category     = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+        using iterator_concept      = std::contiguous_iterator_tag;
+#endif
+        using value_type            = T;
+        using difference_type       = std::ptrdiff_t;
+        using pointer               = const T*;
+        using reference             = const T&;
+
+        const_iterator() = default;
+        explicit const_iterator(const T* ptr) : p{ ptr } { }
+        const_iterator(const iterator& it) : p{ it.raw() } { }
 
         // prefix increment
-        auto operator++() -> const_iterator
+        auto operator++() -> const_iterator&
         {
             ++p;
             return *this;
@@ -112,14 +168,14 @@ public:
             return const_iterator{ res };
         }
 
-        // prefix increment
-        auto operator--() -> const_iterator
+        // prefix decrement
+        auto operator--() -> const_iterator&
         {
             --p;
             return *this;
         }
 
-        // postfix increment
+        // postfix decrement
         auto operator--(int) -> const_iterator
         {
             auto res{ p };
@@ -127,40 +183,73 @@ public:
             return const_iterator{ res };
         }
 
-        auto operator+(size_type count) const -> const_iterator
+        auto operator+=(difference_type count) -> const_iterator&
+        {
+            this->p += count;
+            return *this;
+        }
+
+        auto operator-=(difference_type count) -> const_iterator&
+        {
+            this->p -= count;
+            return *this;
+        }
+
+        auto operator+(difference_type count) const -> const_iterator
         {
             return const_iterator{ this->p + count };
         }
 
-        auto operator-(size_type count) const -> const_iterator
+        auto operator-(difference_type count) const -> const_iterator
         {
             return const_iterator{ this->p - count };
         }
 
-        auto operator!=(const const_iterator& other) const -> bool
+        friend auto operator+(difference_type count, const const_iterator& it) -> const_iterator
         {
-            return this->p != other.p;
+            return const_iterator{ it.p + count };
         }
 
-        auto operator==(const const_iterator& other) const -> bool
+        // these also take a mutable iterator on either side
+        friend auto operator-(const const_iterator& lhs, const const_iterator& rhs) -> difference_type
         {
-            return this->p == other.p;
+            return lhs.p - rhs.p;
         }
 
+        friend auto operator==(const const_iterator& lhs, const const_iterator& rhs) -> bool { return lhs.p == rhs.p; }
+        friend auto operator!=(const const_iterator& lhs, const const_iterator& rhs) -> bool { return lhs.p != rhs.p; }
+        friend auto operator<(const const_iterator& lhs, const const_iterator& rhs) -> bool { return lhs.p < rhs.p; }
+        friend auto operator>(const const_iterator& lhs, const const_iterator& rhs) -> bool { return lhs.p > rhs.p; }
+        friend auto operator<=(const const_iterator& lhs, const const_iterator& rhs) -> bool { return lhs.p <= rhs.p; }
+        friend auto operator>=(const const_iterator& lhs, const const_iterator& rhs) -> bool { return lhs.p >= rhs.p; }
+
         auto operator*() const -> const_reference_type { return *p; }
-        auto operator->() const -> pointer_type { return p; }
+        auto operator->() const -> const T* { return p; }
+        auto operator[](difference_type index) const -> const_reference_type { return p[index]; }
 
-        auto raw() const -> pointer_type { return p; }
+        auto raw() const -> const T* { return p; }
 
     private:
-        pointer_type p{};
+        const T* p{};
     };
 
+    using reverse_iterator          = std::reverse_iterator<iterator>;
+    using const_reverse_iterator    = std::reverse_iterator<const_iterator>;
+
     ///
     /// Default constructor
     ///
-    vector()
-        :   m_array{ nullptr }, m_count{}, m_capacity{}
+    vector() noexcept(noexcept(allocator_type()))
+        :   m_alloc{}, m_array{ nullptr }, m_count{}, m_capacity{}
+    {
+
+    }
+
+    ///
+    /// Default constructor. Memory is obtained from "alloc"
+    ///
+    explicit vector(const allocator_type& alloc) noexcept
+        :   m_alloc{ alloc }, m_array{ nullptr }, m_count{}, m_capacity{}
     {
 
     }
@@ -168,16 +257,18 @@ public:
     ///
     /// Parametrized constructor. Reserve space to hold at least "count" elements
     ///
-    vector(size_type count)
-        :   m_array{ nullptr }, m_count{ 0 }, m_capacity{ count }
+    vector(size_type count, const allocator_type& alloc = allocator_type())
+        :   m_alloc{ alloc }, m_array{ nullptr }, m_count{ 0 }, m_capacity{ count }
     {
         if (count != 0)
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * count, std::nothrow));
-
-        if (not this->m_array)
         {
-            std::printf("could not allocate block of memory...");
-            this->m_capacity = 0;
+            this->m_array = allocate_block(this->m_capacity);
+
+            if (not this->m_array)
+            {
+                this->m_capacity = 0;
+                Errors::on_allocation_failure("could not allocate block of memory...");
+            }
         }
     }
 
@@ -185,133 +276,87 @@ public:
     /// Parametrized constructor. Initializes vector
     /// with the elements from "content"
     ///
-    vector(std::initializer_list<T>&& content)
-        :   m_array{ static_cast<pointer_type>(::operator new(sizeof(value_type) * content.size(), std::nothrow)) },
-            m_count{ content.size() }, m_capacity{ content.size() }
+    vector(std::initializer_list<T>&& content, const allocator_type& alloc = allocator_type())
+        :   m_alloc{ alloc }, m_array{ nullptr }, m_count{}, m_capacity{}
     {
-        if (this->m_array)
-            std::memcpy(static_cast<void*>(this->m_array), static_cast<const void*>(content.begin()),
-                content.size() * sizeof(value_type));
-            // std::copy(content.begin(), content.end(), this->m_array);
-        else
-        {
-            std::printf("could not allocate block of memory...");
-            this->m_count = 0;
-            this->m_capacity = 0;
-        }
+        copy_into_empty(content.begin(), content.size());
     }
 
     ///
     /// Parametrized constructor. Initialize this vector with elements
     /// within the ranged given by "first" and "last"
     ///
-    vector(iterator first, iterator last)
-        :   m_array{ nullptr }, m_count{}, m_capacity{}
+    vector(iterator first, iterator last, const allocator_type& alloc = allocator_type())
+        :   m_alloc{ alloc }, m_array{ nullptr }, m_count{}, m_capacity{}
     {
-        // represents the amount of bytes between first and last
-        size_type new_block_size{ sizeof(value_type) * std::distance(first.raw(), last.raw()) };
-
-        if (new_block_size != 0)
-        {
-            // new_block_size represents the size in bytes of the new block
-            this->m_array = static_cast<pointer_type>(::operator new(new_block_size, std::nothrow));
-
-            if (this->m_array)
-            {
-                std::memcpy(static_cast<void*>(this->m_array), static_cast<const void*>(first.raw()),
-                    new_block_size );
-                //std::copy(first.raw(), last.raw(), this->m_array);
-                this->m_count = new_block_size / sizeof(value_type);
-                this->m_capacity = new_block_size / sizeof(value_type);
-
-            }
-            else
-            {
-                std::printf("could not allocate block of memory...");
-            }
-        }
+        // represents the amount of elements between first and last
+        copy_into_empty(first.raw(), static_cast<size_type>(std::distance(first.raw(), last.raw())));
     }
 
     ///
     /// Parametrized constructor. Initialize this vector with "count"
     /// elements starting from "begin"
     ///
-    vector(iterator first, size_type count)
-        :   m_array{ nullptr }, m_count{ count }, m_capacity{ count }
+    vector(iterator first, size_type count, const allocator_type& alloc = allocator_type())
+        :   m_alloc{ alloc }, m_array{ nullptr }, m_count{}, m_capacity{}
     {
-        // TODO: still needs testing
-        if (count != 0)
-        {
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * count, std::nothrow));
-
-            if (this->m_array)
-            {
-                std::memcpy(static_cast<void*>(this->m_array), static_cast<const void*>(first.raw()),
-                    count * sizeof(value_type));
-                // std::copy(first.raw(), first.raw() + count, this->m_array);
-                this->m_count = count;
-                this->m_capacity = count;
-            }
-            else
-            {
-                std::printf("could not allocate block of memory...");
-                this->m_count = 0;
-                this->m_capacity = 0;
-            }
-        }
+        copy_into_empty(first.raw(), count);
     }
 
     ///
     /// Copy constructor. Initialize this vector with elements from "other"
     ///
     vector(const vector& other)
-        :   m_array{ nullptr }, m_count{}, m_capacity{}
+        :   vector(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
     {
-        if (other.m_count != 0)
-        {
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * other.m_count, std::nothrow));
 
-            if (this->m_array)
-            {
-                std::memcpy(static_cast<void*>(this->m_array), static_cast<const void*>(other.m_array),
-                    other.m_count * sizeof(value_type));
-                // std::copy(other.m_array, other.m_array + other.m_count, this->m_array);
-                this->m_count = other.m_count;
-                this->m_capacity = other.m_capacity;
-            }
-            else
-            {
-                std::printf("could not allocate block of memory...");
-                this->m_count = 0;
-                this->m_capacity = 0;
-            }
-        }
     }
 
     ///
-    /// Assigment operator. Deep copy of "other"
+    /// Copy constructor. Initialize this vector with elements
+    /// from "other" using "alloc" to obtain memory
+    ///
+    vector(const vector& other, const allocator_type& alloc)
+        :   m_alloc{ alloc }, m_array{ nullptr }, m_count{}, m_capacity{}
+    {
+        copy_into_empty(other.m_array, other.m_count);
+    }
+
+    ///
+    /// Assigment operator. Deep copy of "other". The current
+    /// block is reused if it is big enough to hold every element
     ///
     vector& operator=(const vector& other)
     {
         if (this != &other)
         {
-            // clean up previous block
-            for (size_type index{}; index < m_count; ++index)
-                this->m_array[index].~T();
-            ::operator delete(this->m_array);
+            destroy_elements();
+            this->m_count = 0;
+
+            bool reuse_block{ other.m_count <= this->m_capacity };
 
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * other.m_count, std::nothrow));
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+                reuse_block = reuse_block and this->m_alloc == other.m_alloc;
 
-            if (this->m_array)
+            if (reuse_block)
             {
-                std::memcpy(static_cast<void*>(this->m_array), static_cast<const void*>(other.m_array),
-                    other.m_count * sizeof(value_type));
-                // std::copy(other.m_array, other.m_array + other.m_count, this->m_array);
+                KT_INSTRUMENT(on_copy<T>(other.m_count));
+                uninitialized_copy_n(this->m_alloc, static_cast<const T*>(other.m_array), other.m_count, this->m_array);
                 this->m_count = other.m_count;
-                this->m_capacity = other.m_capacity;
+
+                return *this;
             }
-            else
-                std::printf("could not allocate block of memory...");
+
+            // clean up previous block
+            deallocate_block(this->m_array, this->m_capacity);
+
+            this->m_array = nullptr;
+            this->m_capacity = 0;
+
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+                this->m_alloc = other.m_alloc;
+
+            copy_into_empty(other.m_array, other.m_count);
         }
 
         return *this;
@@ -320,15 +365,29 @@ public:
     ///
     /// Move constructor
     ///
-    vector(vector&& other)
-        :   m_array{ other.m_array }, m_count{ other.m_count }, m_capacity{ other.m_capacity }
+    vector(vector&& other) noexcept
+        :   m_alloc{ std::move(other.m_alloc) }, m_array{ other.m_array },
+            m_count{ other.m_count }, m_capacity{ other.m_capacity }
+    {
+        other.m_array = nullptr;
+        other.m_count = 0;
+        other.m_capacity = 0;
+    }
+
+    ///
+    /// Move constructor. If "alloc" can not free the memory owned
+    /// by "other" the elements are moved one by one into a new block
+    ///
+    vector(vector&& other, const allocator_type& alloc)
+        :   m_alloc{ alloc }, m_array{ nullptr }, m_count{}, m_capacity{}
     {
-        if (other.m_capacity != 0)
+        if (this->m_alloc == other.m_alloc)
         {
-            other.m_array = nullptr;
-            other.m_count = 0;
-            other.m_capacity = 0;
+            steal(other);
+            return;
         }
+
+        move_elements_from(other);
     }
 
     ///
@@ -336,32 +395,70 @@ public:
     ///
     ~vector()
     {
-        // cleanup
-        for (size_type index{}; index < m_count; ++index)
-            this->m_array[index].~T();
+        KT_INSTRUMENT(on_destroy<T>(this->m_count, this->m_capacity));
 
-        ::operator delete(this->m_array);
+        // cleanup
+        destroy_elements();
+        deallocate_block(this->m_array, this->m_capacity);
     }
 
     ///
-    /// Assigment operator
+    /// Assigment operator. The block owned by "other" is taken over
+    /// when the allocators allow it, otherwise elements are moved one by one
     ///
-    vector& operator=(vector&& other)
+    vector& operator=(vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value
+        or alloc_traits::is_always_equal::value)
     {
         if (this != &other)
         {
-            this->m_array = other.m_array;
-            this->m_count = other.m_count;
-            this->m_capacity = other.m_capacity;
+            destroy_elements();
+            deallocate_block(this->m_array, this->m_capacity);
+
+            this->m_array = nullptr;
+            this->m_count = 0;
+            this->m_capacity = 0;
 
-            other.m_array = nullptr;
-            other.m_count = 0;
-            other.m_capacity = 0;
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                this->m_alloc = std::move(other.m_alloc);
+                steal(other);
+            }
+            else
+            {
+                if (this->m_alloc == other.m_alloc)
+                    steal(other);
+                else
+                    move_elements_from(other);
+            }
         }
 
         return *this;
     }
 
+    ///
+    /// Exchange the contents of this vector and "other". Allocators are
+    /// swapped only if they propagate on swap, otherwise they must compare equal
+    ///
+    auto swap(vector& other) noexcept -> void
+    {
+        using std::swap;
+
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+            swap(this->m_alloc, other.m_alloc);
+
+        swap(this->m_array, other.m_array);
+        swap(this->m_count, other.m_count);
+        swap(this->m_capacity, other.m_capacity);
+    }
+
+    ///
+    /// Returns a copy of the allocator used by this vector
+    ///
+    auto get_allocator() const -> allocator_type
+    {
+        return this->m_alloc;
+    }
+
     ///
     /// Amount of elements in the vector
     ///
@@ -403,223 +500,552 @@ public:
     }
 
     ///
-    /// Return reference to element at postion "index" throws "out_of_bounds"
-    /// exception if index is not within the range of valid elements
-    /// or "empty_vector" if the vector has no elements
+    /// Returns a pointer to the underlying block of memory
     ///
-    auto at(size_type index) -> reference_type
+    auto data() -> pointer_type
     {
-        try
-        {
-            if (this->m_count == 0)
-                throw empty_vector{};
-            if (not (index < this->m_count))
-                throw out_of_bounds{};
-
-        }
-        catch (const out_of_bounds& oob)
-        {
-            std::printf("%s", oob.what());
-        }
-        catch (const empty_vector& ema)
-        {
-            std::printf("%s", ema.what());
-        }
-        catch(...)
-        {
-            std::printf("Other exceptions thrown");
-        }
-
-        return this->m_array[index];
+        return this->m_array;
     }
 
     ///
-    /// Return constant reference to element at postion "index" throws "out_of_bounds"
-    /// exception if index is not within the range of valid elements or "empty_vector"
-    /// if the vector has no elements
+    /// Returns a constant pointer to the underlying block of memory
     ///
-    auto at(size_type index) const -> const_reference_type
+    auto data() const -> const T*
     {
-        try
-        {
-            if (this->m_count == 0)
-                throw empty_vector{};
-            if (not (index < this->m_count))
-                throw out_of_bounds{};
+        return this->m_array;
+    }
 
-        }
-        catch (const out_of_bounds& oob)
-        {
-            std::printf("%s", oob.what());
-        }
-        catch (const empty_vector& ema)
-        {
-             std::printf("%s", ema.what());
-        }
-        catch(...)
-        {
-            std::printf("Other exceptions thrown");
-        }
+    ///
+    /// Return reference to element at postion "index". An index past the end
+    /// goes to the error policy, which by default throws "empty_vector" if the
+    /// vector has no elements and "out_of_bounds" otherwise
+    ///
+    auto at(size_type index) -> reference_type
+    {
+        if (not (index < this->m_count))
+            Errors::on_out_of_bounds(index, this->m_count);
 
         return this->m_array[index];
     }
 
     ///
-    /// Reserve a block of memory to hold count elements
+    /// Return constant reference to element at postion "index". An index past
+    /// the end goes to the error policy, which by default throws "empty_vector"
+    /// if the vector has no elements and "out_of_bounds" otherwise
     ///
-    auto reserve(size_type count) -> void
+    auto at(size_type index) const -> const_reference_type
     {
-        // TODO
-
-        // this function can be called at any point and
-        // state of the vector in the program
+        if (not (index < this->m_count))
+            Errors::on_out_of_bounds(index, this->m_count);
 
+        return this->m_array[index];
     }
 
     ///
-    /// Adjust vector to contain count elements
+    /// Pointer to the element at postion "index", nullptr if there is none.
+    /// Never goes through the error policy
     ///
-    auto resize(size_type count) -> void;
+    auto try_at(size_type index) -> pointer_type
+    {
+        return index < this->m_count ? this->m_array + index : nullptr;
+    }
+
+    auto try_at(size_type index) const -> const T*
+    {
+        return index < this->m_count ? this->m_array + index : nullptr;
+    }
 
     ///
-    /// Insert elements at the end
+    /// Reserve a block of memory to hold count elements
     ///
-    template <typename... Args>
-    auto emplace_back(Args&&... args) -> void
+    auto reserve(size_type count) -> void
     {
-        if (this->m_count == this->m_capacity)
-            reallocate();
-
-        // construct in place
-        new(&this->m_array[this->m_count++]) value_type(std::forward<Args>(args)...);
+        // this function can be called at any point and
+        // state of the vector in the program
+        if (count > this->m_capacity)
+            reallocate(count);
     }
 
     ///
-    /// Concatenate the contents of this vector and "other"
-    /// This vector contains the result of the concatenation
+    /// Adjust vector to contain count elements. New elements are value initialized
     ///
-    auto append(const vector& other) -> void
+    auto resize(size_type count) -> void
     {
-        if (not other.empty())
+        if (count <= this->m_count)
         {
-            pointer_type new_block{ static_cast<pointer_type>
-                (::operator new(sizeof(value_type) * (this->m_count + other.m_count), std::nothrow)) };
-
-            if (new_block)
-            {
-                std::memcpy(static_cast<void*>(new_block), static_cast<const void*>(this->m_array),
-                    this->m_count * sizeof(value_type));
-                std::memcpy(static_cast<void*>(new_block + this->m_count), static_cast<const void*>(other.m_array),
-                    other.m_count * sizeof(value_type));
-
-                ::operator delete(static_cast<void*>(this->m_array));
+            remove_n(this->m_count - count);
+            return;
+        }
 
-                this->m_array = new_block;
-                this->m_count = this->m_count + other.m_count;
-                this->m_capacity = this->m_count + other.m_count;
+        if (count > this->m_capacity and not reallocate(Growth::next_capacity(this->m_capacity, count, sizeof(value_type))))
+            return;
 
-            }
-            else
-            {
-                std::printf("failed to concatenate. Could not allocate block of memory...");
-                return;
-            }
-        }
+        for (; this->m_count < count; ++this->m_count)
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count);
     }
 
     ///
-    /// Destroy the last n elements. If there is less than
-    /// count elements, it empties the vector
+    /// Adjust vector to contain count elements. New elements are copies of "value"
     ///
-    auto remove_n(size_type count) -> void
+    auto resize(size_type count, const_reference_type value) -> void
     {
-        if (count < this->m_count)
+        if (count <= this->m_count)
         {
-            std::for_each(this->m_array,
-                this->m_array + count, [](reference_type info) -> void { info.~T(); });
-
-            this->m_count -= count;
+            remove_n(this->m_count - count);
+            return;
         }
-        else
+
+        if (count > this->m_capacity)
         {
-            std::for_each(this->m_array,
-                this->m_array + this->m_count, [](reference_type info) -> void { info.~T(); });
+            // "value" may be one of our elements, copy it before the block moves
+            value_type copy(value);
 
-            this->m_count = 0;
+            if (reallocate(Growth::next_capacity(this->m_capacity, count, sizeof(value_type))))
+                for (; this->m_count < count; ++this->m_count)
+                    alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, copy);
+
+            return;
         }
+
+        for (; this->m_count < count; ++this->m_count)
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, value);
     }
 
     ///
-    /// Insert one element at the end of the vector
+    /// Release the unused capacity. The elements are moved to a block
+    /// as big as needed, as far as the allocator allows, or the block is freed if the vector is empty
     ///
-    auto push_back(const_reference_type info) -> void
+    auto shrink_to_fit() -> void
     {
-        // if capacity == count:
-        // allocate new block
-        // copy data from old block to new block
-        // add new data
-        // delete old block
+        if (this->m_count == this->m_capacity)
+            return;
 
-        // otherwise (capacity > count)
-        // put new element at the end
-        // increase count by 1
-        if (this->m_capacity > this->m_count)
-        {
-            new(&this->m_array[this->m_count]) value_type(info);
-            this->m_count += 1;
-        }
-        else
+        if (this->m_count == 0)
         {
-            reallocate();
-
-            // if reallocate fails, m_size will remain same as m_capacity
-            // preventing from appending new element
-            if (this->m_capacity == this->m_count)
-            {
-                std::printf("could not insert new element due to error while reallocating...");
-                return;
-            }
+            deallocate_block(this->m_array, this->m_capacity);
+            this->m_array = nullptr;
+            this->m_capacity = 0;
 
-            new(&this->m_array[this->m_count]) value_type(info);
-            this->m_count += 1;
+            return;
         }
+
+        reallocate(this->m_count);
     }
 
     ///
-    /// Insert one element at the end of the vector
-    /// with support for move semantics
+    /// Reserve a block of memory to hold count elements. Returns false,
+    /// leaving the vector untouched, if the block could not be obtained.
+    /// Never goes through the error policy
     ///
-    auto push_back(T&& info) -> void
+    auto try_reserve(size_type count) -> bool
     {
-        // if capacity == count:
-        // allocate new block
-        // copy data from old block to new block
-        // add new data
-        // delete old block
+        return count <= this->m_capacity or try_reallocate(count);
+    }
 
-        // otherwise (capacity > count)
-        // put new element at the end
-        // increase count by 1
-        if (this->m_capacity > this->m_count)
+    ///
+    /// Insert elements at the end. Returns false, leaving the vector
+    /// untouched, if it had to grow and no block could be obtained.
+    /// Never goes through the error policy
+    ///
+    template <typename... Args>
+    auto try_emplace_back(Args&&... args) -> bool
+    {
+        if (this->m_count == this->m_capacity)
         {
-            new(&this->m_array[this->m_count]) value_type(std::move(info));
-            this->m_count += 1;
+            // "args" may refer to an element, build the new one before the block can move
+            T value(std::forward<Args>(args)...);
+
+            if (not try_reallocate(Growth::next_capacity(this->m_capacity, this->m_count + 1, sizeof(value_type))))
+                return false;
+
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::move(value));
         }
         else
-        {
-            reallocate();
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::forward<Args>(args)...);
 
-            // if reallocate fails, m_size will remain same as m_capacity
-            // preventing from appending new element
-            if (this->m_capacity == this->m_count)
-            {
-                std::printf("could not insert new element due to error while reallocating...");
-                return;
-            }
+        this->m_count += 1;
 
-            new(&this->m_array[this->m_count]) value_type(std::move(info));
-            this->m_count += 1;
-        }
+        return true;
+    }
+
+    auto try_push_back(const_reference_type info) -> bool
+    {
+        return try_emplace_back(info);
+    }
+
+    auto try_push_back(T&& info) -> bool
+    {
+        return try_emplace_back(std::move(info));
+    }
+
+    ///
+    /// Insert elements at the end
+    ///
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        if (this->m_count == this->m_capacity)
+        {
+            grow_and_emplace(std::forward<Args>(args)...);
+            return;
+        }
+
+        // construct in place
+        alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::forward<Args>(args)...);
+        this->m_count += 1;
+    }
+
+    ///
+    /// Concatenate the contents of this vector and "other"
+    /// This vector contains the result of the concatenation
+    ///
+    auto append(const vector& other) -> void
+    {
+        insert_forward(this->m_count, static_cast<const T*>(other.m_array), other.m_count);
+    }
+
+    ///
+    /// Concatenate the contents of this vector and "other". The elements of
+    /// "other" are relocated in bulk instead of copied and "other" is left empty
+    ///
+    auto append(vector&& other) -> void
+    {
+        if (other.m_count == 0 or &other == this)
+            return;
+
+        if (this->m_count == 0 and (alloc_traits::is_always_equal::value or this->m_alloc == other.m_alloc))
+        {
+            // nothing to keep, adopt the block of "other"
+            destroy_elements();
+            deallocate_block(this->m_array, this->m_capacity);
+            steal(other);
+
+            return;
+        }
+
+        if (this->m_capacity - this->m_count < other.m_count
+            and not reallocate(Growth::next_capacity(this->m_capacity, this->m_count + other.m_count, sizeof(value_type))))
+            return;
+
+        KT_INSTRUMENT(on_copy<T>(other.m_count));
+        relocate_n(this->m_alloc, other.m_array, other.m_count, this->m_array + this->m_count);
+
+        this->m_count += other.m_count;
+        other.m_count = 0;
+    }
+
+    ///
+    /// Append the elements within the range given by "first" and "last".
+    /// Forward ranges are sized up front so at most one reallocation happens,
+    /// move iterators relocate the elements instead of copying them
+    ///
+    template <typename InputIt>
+    auto append(InputIt first, InputIt last) -> void
+    {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>)
+            insert_forward(this->m_count, first, static_cast<size_type>(std::distance(first, last)));
+        else
+            for (; first != last; ++first)
+                emplace_back(*first);
+    }
+
+    auto append(iterator first, iterator last) -> void
+    {
+        append(first.raw(), last.raw());
+    }
+
+    auto append(const_iterator first, const_iterator last) -> void
+    {
+        append(first.raw(), last.raw());
+    }
+
+    ///
+    /// Insert the elements within the range given by "first" and "last" before
+    /// "pos" and return an iterator to the first inserted element. The range must
+    /// not refer to elements of this vector
+    ///
+    template <typename InputIt>
+    auto insert(iterator pos, InputIt first, InputIt last) -> iterator
+    {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        const size_type index{ static_cast<size_type>(pos.raw() - this->m_array) };
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>)
+        {
+            pointer_type inserted{ insert_forward(index, first, static_cast<size_type>(std::distance(first, last))) };
+
+            return iterator{ inserted ? inserted : this->m_array + index };
+        }
+        else
+        {
+            // single pass range, append and rotate the new elements into place
+            const size_type old_count{ this->m_count };
+
+            for (; first != last; ++first)
+                emplace_back(*first);
+
+            std::rotate(this->m_array + index, this->m_array + old_count, this->m_array + this->m_count);
+
+            return iterator{ this->m_array + index };
+        }
+    }
+
+    auto insert(iterator pos, iterator first, iterator last) -> iterator
+    {
+        return insert(pos, first.raw(), last.raw());
+    }
+
+    auto insert(iterator pos, const_iterator first, const_iterator last) -> iterator
+    {
+        return insert(pos, first.raw(), last.raw());
+    }
+
+    ///
+    /// Construct "count" elements at the end, each one from "args".
+    /// "args" must not refer to elements of this vector
+    ///
+    template <typename... Args>
+    auto emplace_back_n(size_type count, const Args&... args) -> void
+    {
+        if (this->m_capacity - this->m_count < count
+            and not reallocate(Growth::next_capacity(this->m_capacity, this->m_count + count, sizeof(value_type))))
+            return;
+
+        for (const size_type new_count{ this->m_count + count }; this->m_count < new_count; ++this->m_count)
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, args...);
+    }
+
+    ///
+    /// Insert one element at the end without checking the capacity.
+    /// There must be room for it, usually because of a previous call to reserve()
+    ///
+    auto unchecked_push_back(const_reference_type info) -> void
+    {
+        alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, info);
+        this->m_count += 1;
+    }
+
+    ///
+    /// Insert one element at the end without checking the capacity
+    /// with support for move semantics
+    ///
+    auto unchecked_push_back(T&& info) -> void
+    {
+        alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::move(info));
+        this->m_count += 1;
+    }
+
+    ///
+    /// Adjust vector to contain count elements. New elements are default
+    /// initialized, which leaves them untouched for trivial types. Meant
+    /// for buffers that are overwritten right after growing
+    ///
+    auto resize_default_init(size_type count) -> void
+    {
+        if (count <= this->m_count)
+        {
+            remove_n(this->m_count - count);
+            return;
+        }
+
+        if (count > this->m_capacity and not reallocate(Growth::next_capacity(this->m_capacity, count, sizeof(value_type))))
+            return;
+
+        if constexpr (std::is_trivially_default_constructible_v<T>)
+            this->m_count = count;
+        else
+            for (; this->m_count < count; ++this->m_count)
+                ::new (static_cast<void*>(this->m_array + this->m_count)) value_type;
+    }
+
+    ///
+    /// Destroy the last n elements. If there is less than
+    /// count elements, it empties the vector
+    ///
+    auto remove_n(size_type count) -> void
+    {
+        if (count < this->m_count)
+        {
+            destroy_n(this->m_alloc, this->m_array + this->m_count - count, count);
+
+            this->m_count -= count;
+        }
+        else
+            clear();
+    }
+
+    ///
+    /// Remove the element at "pos", keeping the order of the others.
+    /// Returns an iterator to the element that followed the removed one
+    ///
+    auto erase(iterator pos) -> iterator
+    {
+        const size_type index{ static_cast<size_type>(pos.raw() - this->m_array) };
+        erase_range(index, index + 1);
+
+        return iterator{ this->m_array + index };
+    }
+
+    ///
+    /// Remove the elements in the range given by "first" and "last", keeping
+    /// the order of the others. Returns an iterator to the element that
+    /// followed the last removed one
+    ///
+    auto erase(iterator first, iterator last) -> iterator
+    {
+        const size_type index{ static_cast<size_type>(first.raw() - this->m_array) };
+        erase_range(index, static_cast<size_type>(last.raw() - this->m_array));
+
+        return iterator{ this->m_array + index };
+    }
+
+    ///
+    /// Remove every element "pred" returns true for in a single pass, keeping
+    /// the order of the others. Returns the amount of removed elements
+    ///
+    template <typename Predicate>
+    auto erase_if(Predicate pred) -> size_type
+    {
+        size_type kept{};
+
+        while (kept < this->m_count and not pred(this->m_array[kept]))
+            ++kept;
+
+        if (kept == this->m_count)
+            return 0;
+
+        for (size_type index{ kept + 1 }; index < this->m_count; ++index)
+            if (not pred(this->m_array[index]))
+            {
+                this->m_array[kept] = std::move(this->m_array[index]);
+                ++kept;
+            }
+
+        const size_type removed{ this->m_count - kept };
+        remove_n(removed);
+
+        return removed;
+    }
+
+    ///
+    /// Remove the element at "pos" in constant time by moving the last element
+    /// into its place, which does not keep the order. Returns an iterator to
+    /// the element now at "pos"
+    ///
+    auto swap_remove(iterator pos) -> iterator
+    {
+        const size_type index{ static_cast<size_type>(pos.raw() - this->m_array) };
+
+        if (index + 1 != this->m_count)
+            this->m_array[index] = std::move(this->m_array[this->m_count - 1]);
+
+        pop_back();
+
+        return iterator{ this->m_array + index };
+    }
+
+    ///
+    /// Remove the elements at the given indices, which have to be sorted in
+    /// ascending order, in one sweep keeping the order of the others. The
+    /// elements between two removed ones are moved down as one run, with a
+    /// single memmove for trivially relocatable types. Indices out of range,
+    /// repeated or out of order are ignored. Returns the amount of removed elements
+    ///
+    template <typename Indices>
+    auto remove_indices(const Indices& sorted_indices) -> size_type
+    {
+        size_type write{};
+        size_type read{};
+        size_type removed{};
+
+        for (const size_type index : sorted_indices)
+        {
+            if (index >= this->m_count or index < read)
+                continue;
+
+            if (removed == 0)
+                write = index;
+            else
+            {
+                move_run(read, index - read, write);
+                write += index - read;
+            }
+
+            if constexpr (is_trivially_relocatable_v<T>)
+                alloc_traits::destroy(this->m_alloc, this->m_array + index);
+
+            read = index + 1;
+            ++removed;
+        }
+
+        if (removed == 0)
+            return 0;
+
+        move_run(read, this->m_count - read, write);
+        write += this->m_count - read;
+
+        // the moved from elements and the removed ones still waiting at the end
+        if constexpr (not is_trivially_relocatable_v<T>)
+            destroy_n(this->m_alloc, this->m_array + write, this->m_count - write);
+
+        this->m_count = write;
+
+        return removed;
+    }
+
+    auto remove_indices(std::initializer_list<size_type> sorted_indices) -> size_type
+    {
+        return remove_indices<std::initializer_list<size_type>>(sorted_indices);
+    }
+
+    ///
+    /// Insert one element at the end of the vector
+    ///
+    auto push_back(const_reference_type info) -> void
+    {
+        // if capacity == count:
+        // allocate new block
+        // copy data from old block to new block
+        // add new data
+        // delete old block
+
+        // otherwise (capacity > count)
+        // put new element at the end
+        // increase count by 1
+        if (this->m_capacity > this->m_count)
+        {
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, info);
+            this->m_count += 1;
+        }
+        else
+            grow_and_emplace(info);
+    }
+
+    ///
+    /// Insert one element at the end of the vector
+    /// with support for move semantics
+    ///
+    auto push_back(T&& info) -> void
+    {
+        // if capacity == count:
+        // allocate new block
+        // copy data from old block to new block
+        // add new data
+        // delete old block
+
+        // otherwise (capacity > count)
+        // put new element at the end
+        // increase count by 1
+        if (this->m_capacity > this->m_count)
+        {
+            alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::move(info));
+            this->m_count += 1;
+        }
+        else
+            grow_and_emplace(std::move(info));
     }
 
     ///
@@ -629,7 +1055,7 @@ public:
     {
         if (this->m_count != 0)
         {
-            this->m_array[this->m_count - 1].~T();
+            alloc_traits::destroy(this->m_alloc, this->m_array + this->m_count - 1);
             this->m_count -= 1;
         }
 
@@ -640,8 +1066,7 @@ public:
     ///
     auto clear() -> void
     {
-        std::for_each(this->m_array,
-            this->m_array + this->m_count, [](T& info) -> void { info.~T(); });
+        destroy_elements();
 
         this->m_count = 0;
     }
@@ -694,61 +1119,531 @@ public:
         return const_iterator{ this->m_array + this->m_count };
     }
 
+    ///
+    /// Returns a reverse iterator to the last element of the vector
+    ///
+    auto rbegin() -> reverse_iterator
+    {
+        return reverse_iterator{ end() };
+    }
+
+    ///
+    /// Returns a reverse iterator before the first element of the vector
+    ///
+    auto rend() -> reverse_iterator
+    {
+        return reverse_iterator{ begin() };
+    }
+
+    auto rbegin() const -> const_reverse_iterator
+    {
+        return const_reverse_iterator{ end() };
+    }
+
+    auto rend() const -> const_reverse_iterator
+    {
+        return const_reverse_iterator{ begin() };
+    }
+
+    auto crbegin() const -> const_reverse_iterator
+    {
+        return rbegin();
+    }
+
+    auto crend() const -> const_reverse_iterator
+    {
+        return rend();
+    }
+
 
 private:
-    static constexpr size_type grow_factor{ 2 };
+    ///
+    /// Move every element into a new block able to hold "new_block_count" elements.
+    /// Returns false, leaving the vector untouched, if the block could not be
+    /// obtained, after handing the failure to the error policy
+    ///
+    auto reallocate(size_type new_block_count) -> bool
+    {
+        if (try_reallocate(new_block_count))
+            return true;
+
+        Errors::on_allocation_failure("Failed to allocate new block of memory");
+        return false;
+    }
 
-    void reallocate()
+    ///
+    /// Same as reallocate without involving the error policy, for the try_* members
+    ///
+    auto try_reallocate(size_type new_block_count) -> bool
     {
-        size_type new_block_count{ (!this->m_capacity) ? 1 : (this->m_capacity * grow_factor) };
-        pointer_type new_block{ static_cast<pointer_type>(::operator new(sizeof(T) * new_block_count, std::nothrow)) };
+        if (reallocate_in_place(new_block_count))
+            return true;
+
+        pointer_type new_block{ allocate_block(new_block_count) };
 
         if (not new_block)
+            return false;
+
+        KT_INSTRUMENT(on_reallocate<T>(this->m_capacity, new_block_count, this->m_count));
+
+        try
+        {
+            relocate_n(this->m_alloc, this->m_array, this->m_count, new_block);
+        }
+        catch (...)
         {
-            std::printf("Failed to allocate new block of memory");
+            deallocate_block(new_block, new_block_count);
+            throw;
+        }
+
+        deallocate_block(this->m_array, this->m_capacity);
+
+        this->m_array = new_block;
+        this->m_capacity = new_block_count;
+
+        return true;
+    }
+
+    ///
+    /// Move every element into a bigger block and construct a new element at the
+    /// end of it. The new element is built before the old block is released, so
+    /// "args" may safely refer to elements of this vector
+    ///
+    template <typename... Args>
+    auto grow_and_emplace(Args&&... args) -> void
+    {
+        const size_type new_block_count{ Growth::next_capacity(this->m_capacity, this->m_count + 1, sizeof(value_type)) };
+
+        if constexpr (reallocates_in_place)
+        {
+            // "args" may refer to an element, build the new one before the block can move
+            T value(std::forward<Args>(args)...);
+
+            if (reallocate_in_place(new_block_count))
+            {
+                alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::move(value));
+                this->m_count += 1;
+            }
+            else
+                relocate_and_emplace(new_block_count, std::move(value));
+        }
+        else
+            relocate_and_emplace(new_block_count, std::forward<Args>(args)...);
+    }
+
+    ///
+    /// Second half of grow_and_emplace: a new block, the new element and then the old ones
+    ///
+    template <typename... Args>
+    auto relocate_and_emplace(size_type new_block_count, Args&&... args) -> void
+    {
+        pointer_type new_block{ allocate_block(new_block_count) };
+
+        if (not new_block)
+        {
+            Errors::on_allocation_failure("could not insert new element due to error while reallocating...");
             return;
         }
 
-        std::memcpy(static_cast<void*>(new_block), static_cast<const void*>(this->m_array),
-            this->m_count * sizeof(value_type));
+        try
+        {
+            alloc_traits::construct(this->m_alloc, new_block + this->m_count, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate_block(new_block, new_block_count);
+            throw;
+        }
+
+        KT_INSTRUMENT(on_reallocate<T>(this->m_capacity, new_block_count, this->m_count));
+
+        try
+        {
+            relocate_n(this->m_alloc, this->m_array, this->m_count, new_block);
+        }
+        catch (...)
+        {
+            alloc_traits::destroy(this->m_alloc, new_block + this->m_count);
+            deallocate_block(new_block, new_block_count);
+            throw;
+        }
 
-        ::operator delete(static_cast<void*>(this->m_array));
+        deallocate_block(this->m_array, this->m_capacity);
 
         this->m_array = new_block;
+        this->m_count += 1;
         this->m_capacity = new_block_count;
+    }
+
+    ///
+    /// Construct "count" elements from the forward range starting at "first" before
+    /// position "index". Returns a pointer to the first new element, or nullptr if
+    /// a bigger block was needed and could not be obtained
+    ///
+    template <typename ForwardIt>
+    auto insert_forward(size_type index, ForwardIt first, size_type count) -> pointer_type
+    {
+        if (count == 0)
+            return this->m_array + index;
+
+        const size_type tail{ this->m_count - index };
+
+        if (this->m_capacity - this->m_count >= count and tail == 0)
+        {
+            // appending, nothing to shift. The range may point into this vector
+            pointer_type end{ this->m_array + this->m_count };
+            size_type built{};
+
+            KT_INSTRUMENT(on_copy<T>(count));
+
+            try
+            {
+                for (; built < count; ++built, ++first)
+                    alloc_traits::construct(this->m_alloc, end + built, *first);
+            }
+            catch (...)
+            {
+                destroy_n(this->m_alloc, end, built);
+                throw;
+            }
+
+            this->m_count += count;
+
+            return end;
+        }
+
+        if constexpr (not is_trivially_relocatable_v<T> and not std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this->m_capacity - this->m_count >= count)
+                return insert_assign_backward(index, first, count);
+        }
+        else if (this->m_capacity - this->m_count >= count)
+        {
+            pointer_type gap{ this->m_array + index };
 
+            KT_INSTRUMENT(on_copy<T>(count + tail));
+
+            // open a gap of "count" slots by moving the tail to the right
+            relocate_overlapping(this->m_alloc, gap, tail, gap + count);
+
+            size_type built{};
+
+            try
+            {
+                for (; built < count; ++built, ++first)
+                    alloc_traits::construct(this->m_alloc, gap + built, *first);
+            }
+            catch (...)
+            {
+                destroy_n(this->m_alloc, gap, built);
+                relocate_overlapping(this->m_alloc, gap + count, tail, gap);
+                throw;
+            }
+
+            this->m_count += count;
+
+            return gap;
+        }
+
+        const size_type new_count{ this->m_count + count };
+        size_type new_block_count{ Growth::next_capacity(this->m_capacity, new_count, sizeof(value_type)) };
+        pointer_type new_block{ allocate_block(new_block_count) };
+
+        if (not new_block)
+        {
+            Errors::on_allocation_failure("could not insert new elements due to error while reallocating...");
+            return nullptr;
+        }
+
+        KT_INSTRUMENT(on_reallocate<T>(this->m_capacity, new_block_count, this->m_count));
+        KT_INSTRUMENT(on_copy<T>(count));
+
+        // the new elements go first, the range may still point into the old block
+        size_type built{};
+
+        try
+        {
+            for (; built < count; ++built, ++first)
+                alloc_traits::construct(this->m_alloc, new_block + index + built, *first);
+
+            relocate_n(this->m_alloc, this->m_array, index, new_block);
+        }
+        catch (...)
+        {
+            destroy_n(this->m_alloc, new_block + index, built);
+            deallocate_block(new_block, new_block_count);
+            throw;
+        }
+
+        try
+        {
+            relocate_n(this->m_alloc, this->m_array + index, tail, new_block + index + count);
+        }
+        catch (...)
+        {
+            // the head already lives in the new block, give up on every element
+            destroy_n(this->m_alloc, new_block, index + count);
+            destroy_n(this->m_alloc, this->m_array + index, tail);
+            deallocate_block(new_block, new_block_count);
+            deallocate_block(this->m_array, this->m_capacity);
+
+            this->m_array = nullptr;
+            this->m_count = 0;
+            this->m_capacity = 0;
+            throw;
+        }
+
+        deallocate_block(this->m_array, this->m_capacity);
+
+        this->m_array = new_block;
+        this->m_count = new_count;
+        this->m_capacity = new_block_count;
+
+        return this->m_array + index;
     }
 
-    class out_of_bounds : public std::exception
+    ///
+    /// insert_forward for types whose move constructor may throw, which can not
+    /// be shifted into an uninitialized gap safely. Like std::vector::insert, the
+    /// last elements are moved to the uninitialized end, the others are move
+    /// assigned backwards and the new ones assigned over them. If a move or copy
+    /// throws the vector is left valid but its elements are unspecified
+    ///
+    template <typename ForwardIt>
+    auto insert_assign_backward(size_type index, ForwardIt first, size_type count) -> pointer_type
     {
-    public:
-        out_of_bounds() = default;
-        ~out_of_bounds() = default;
+        const size_type old_count{ this->m_count };
+        const size_type tail{ old_count - index };
+        pointer_type position{ this->m_array + index };
+
+        KT_INSTRUMENT(on_copy<T>(count + tail));
 
-        const char* what() const noexcept override
+        if (tail > count)
         {
-            return this->m_exc.data();
+            // the last "count" elements move to the uninitialized end
+            for (size_type moved{}; moved < count; ++moved, ++this->m_count)
+                alloc_traits::construct(this->m_alloc, this->m_array + old_count + moved,
+                    std::move(this->m_array[old_count - count + moved]));
+
+            std::move_backward(position, this->m_array + old_count - count, this->m_array + old_count);
+            std::copy_n(first, count, position);
         }
+        else
+        {
+            // the new elements past the old end are constructed, the tail moves after them
+            ForwardIt middle{ std::next(first, static_cast<std::ptrdiff_t>(tail)) };
 
-    private:
-        std::string_view m_exc{ "[out_of_bounds]: Index out of bounds\n" };
-    };
+            for (ForwardIt current{ middle }; this->m_count < old_count + count - tail; ++current, ++this->m_count)
+                alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, *current);
+
+            for (size_type moved{}; moved < tail; ++moved, ++this->m_count)
+                alloc_traits::construct(this->m_alloc, this->m_array + this->m_count, std::move(position[moved]));
+
+            std::copy(first, middle, position);
+        }
+
+        return position;
+    }
 
-    class empty_vector : public std::exception
+    ///
+    /// Remove the elements at the indices [first, last) and close the gap
+    ///
+    auto erase_range(size_type first, size_type last) -> void
     {
-    public:
-        empty_vector() = default;
-        ~empty_vector() = default;
+        if (first >= last)
+            return;
+
+        const size_type count{ last - first };
+
+        if constexpr (is_trivially_relocatable_v<T>)
+            destroy_n(this->m_alloc, this->m_array + first, count);
+
+        move_run(last, this->m_count - last, first);
 
-        const char* what() const noexcept override
+        if constexpr (not is_trivially_relocatable_v<T>)
+            destroy_n(this->m_alloc, this->m_array + this->m_count - count, count);
+
+        this->m_count -= count;
+    }
+
+    ///
+    /// Move "count" elements starting at "source" down to "dest". Trivially
+    /// relocatable elements are relocated with one memmove, the destination
+    /// has to be destroyed already; other types are move assigned and the
+    /// source elements are left moved from for the caller to destroy
+    ///
+    auto move_run(size_type source, size_type count, size_type dest) -> void
+    {
+        if (count == 0 or source == dest)
+            return;
+
+        KT_INSTRUMENT(on_copy<T>(count));
+
+        if constexpr (is_trivially_relocatable_v<T>)
+            relocate_overlapping(this->m_alloc, this->m_array + source, count, this->m_array + dest);
+        else
+            std::move(this->m_array + source, this->m_array + source + count, this->m_array + dest);
+    }
+
+    static constexpr bool reallocates_in_place{ can_reallocate_in_place_v<Alloc> and is_trivially_relocatable_v<T> };
+
+    ///
+    /// Let the allocator resize the block, which moves the bytes of the elements
+    /// without copying them one by one. Returns false, leaving the vector
+    /// untouched, if the allocator cannot do it and the caller has to relocate
+    ///
+    auto reallocate_in_place(size_type new_block_count) -> bool
+    {
+        if constexpr (reallocates_in_place)
         {
-            return this->m_exc.data();
+            if (not this->m_array or new_block_count == 0)
+                return false;
+
+            pointer_type block{ this->m_alloc.reallocate(this->m_array, this->m_capacity, new_block_count) };
+
+            if (not block)
+                return false;
+
+            KT_INSTRUMENT(on_reallocate<T>(this->m_capacity, new_block_count, 0));
+
+            this->m_array = block;
+            this->m_capacity = new_block_count;
+
+            return true;
         }
+        else
+        {
+            static_cast<void>(new_block_count);
+            return false;
+        }
+    }
 
-    private:
-        std::string_view m_exc{ "[empty_vector]: vector has no elements\n" };
-    };
+    ///
+    /// Obtain a block for "count" elements from the allocator, "count" is then
+    /// updated to the amount of elements the block holds, more than asked for
+    /// if the allocator reports it through allocate_at_least.
+    /// Returns nullptr if the allocator could not provide it
+    ///
+    auto allocate_block(size_type& count) -> pointer_type
+    {
+        try
+        {
+            if constexpr (allocates_at_least_v<Alloc>)
+            {
+                const auto [block, capacity]{ this->m_alloc.allocate_at_least(count) };
+                count = capacity;
+                KT_INSTRUMENT(on_allocate<T>(count));
 
+                return block;
+            }
+            else
+            {
+                pointer_type block{ alloc_traits::allocate(this->m_alloc, count) };
+                KT_INSTRUMENT(on_allocate<T>(count));
+
+                return block;
+            }
+        }
+        catch (const std::bad_alloc&)
+        {
+            return nullptr;
+        }
+    }
+
+    auto deallocate_block(pointer_type block, size_type count) -> void
+    {
+        if (block)
+            alloc_traits::deallocate(this->m_alloc, block, count);
+    }
+
+    auto destroy_elements() -> void
+    {
+        destroy_n(this->m_alloc, this->m_array, this->m_count);
+    }
+
+    ///
+    /// Allocate a block for "count" elements and copy them from "source".
+    /// Must only be called while this vector owns no block
+    ///
+    auto copy_into_empty(const T* source, size_type count) -> void
+    {
+        if (count == 0)
+            return;
+
+        size_type capacity{ count };
+        this->m_array = allocate_block(capacity);
+
+        if (not this->m_array)
+        {
+            Errors::on_allocation_failure("could not allocate block of memory...");
+            return;
+        }
+
+        KT_INSTRUMENT(on_copy<T>(count));
+
+        try
+        {
+            uninitialized_copy_n(this->m_alloc, source, count, this->m_array);
+        }
+        catch (...)
+        {
+            deallocate_block(this->m_array, capacity);
+            this->m_array = nullptr;
+            throw;
+        }
+
+        this->m_count = count;
+        this->m_capacity = capacity;
+    }
+
+    // take over the block owned by "other", leaving it empty
+    auto steal(vector& other) noexcept -> void
+    {
+        this->m_array = other.m_array;
+        this->m_count = other.m_count;
+        this->m_capacity = other.m_capacity;
+
+        other.m_array = nullptr;
+        other.m_count = 0;
+        other.m_capacity = 0;
+    }
+
+    // used when the allocators differ and the block of "other" can not be adopted
+    auto move_elements_from(vector& other) -> void
+    {
+        if (other.m_count == 0)
+            return;
+
+        size_type capacity{ other.m_count };
+        this->m_array = allocate_block(capacity);
+
+        if (not this->m_array)
+        {
+            Errors::on_allocation_failure("could not allocate block of memory...");
+            return;
+        }
+
+        KT_INSTRUMENT(on_copy<T>(other.m_count));
+
+        try
+        {
+            relocate_n(this->m_alloc, other.m_array, other.m_count, this->m_array);
+        }
+        catch (...)
+        {
+            deallocate_block(this->m_array, capacity);
+            this->m_array = nullptr;
+            throw;
+        }
+
+        this->m_count = other.m_count;
+        this->m_capacity = capacity;
+
+        // the elements of "other" were destroyed by the relocation
+        other.m_count = 0;
+    }
+
+    allocator_type m_alloc;
     pointer_type m_array;
     size_type m_count;
     size_type m_capacity;
@@ -757,6 +1652,12 @@ private:
     // m_capacity >= m_count >= 0
 };
 
+template <typename T, typename Alloc, typename Growth, typename Errors>
+auto swap(vector<T, Alloc, Growth, Errors>& lhs, vector<T, Alloc, Growth, Errors>& rhs) noexcept -> void
+{
+    lhs.swap(rhs);
+}
+
 }   // END KT NAMESPACE
 
 #endif
@@ -0,0 +1,306 @@
+#ifndef VECTOR_VIEW_HH
+#define VECTOR_VIEW_HH
+
+// C++ standard library includes
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+#include "vector.h"
+
+namespace kt
+{
+namespace detail
+{
+    template <typename Container, typename T, typename = void>
+    struct is_viewable : std::false_type {};
+
+    // contiguous containers whose data() converts to T*, such as kt::vector or kt::static_vector
+    template <typename Container, typename T>
+    struct is_viewable<Container, T, std::void_t<decltype(std::declval<Container&>().size()),
+        std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>>
+        : std::true_type {};
+}   // END KT::DETAIL NAMESPACE
+
+template <typename T>
+class chunk_range;
+
+///
+/// Non owning view of "size()" contiguous elements, made of a pointer and
+/// a count. It is built implicitly from a kt::vector, or any container with
+/// data() and size(), so functions taking a vector_view accept whole
+/// vectors and slices of them alike. Slicing never allocates nor copies.
+///
+/// vector_view<const T> only reads the elements, vector_view<T> may also
+/// change them. The viewed elements must outlive the view, and growing
+/// the viewed vector invalidates it like it invalidates iterators.
+///
+/// Offsets and counts past the end are clamped to the end
+///
+template <typename T>
+class vector_view
+{
+    using element_type = std::remove_const_t<T>;
+
+public:
+    using value_type            = element_type;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+
+    // same iterators as kt::vector so views and vectors can be used interchangeably
+    using iterator              = std::conditional_t<std::is_const_v<T>,
+                                    typename vector<element_type>::const_iterator,
+                                    typename vector<element_type>::iterator>;
+
+    static constexpr size_type npos{ static_cast<size_type>(-1) };
+
+    ///
+    /// Default constructor. The view is empty
+    ///
+    constexpr vector_view() noexcept = default;
+
+    ///
+    /// View "count" elements starting at "first"
+    ///
+    constexpr vector_view(pointer_type first, size_type count) noexcept
+        :   m_data{ first }, m_count{ count }
+    {
+
+    }
+
+    ///
+    /// View the elements in [first, last)
+    ///
+    constexpr vector_view(pointer_type first, pointer_type last) noexcept
+        :   m_data{ first }, m_count{ static_cast<size_type>(last - first) }
+    {
+
+    }
+
+    ///
+    /// View every element of "container"
+    ///
+    template <typename Container, typename = std::enable_if_t<detail::is_viewable<Container, T>::value
+        and not std::is_same_v<std::decay_t<Container>, vector_view>>>
+    constexpr vector_view(Container& container) noexcept
+        :   m_data{ container.data() }, m_count{ container.size() }
+    {
+
+    }
+
+    ///
+    /// A view of T converts to a view of const T
+    ///
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> and not std::is_same_v<U, T>>>
+    constexpr vector_view(const vector_view<U>& other) noexcept
+        :   m_data{ other.data() }, m_count{ other.size() }
+    {
+
+    }
+
+    constexpr auto size() const noexcept -> size_type
+    {
+        return this->m_count;
+    }
+
+    constexpr auto empty() const noexcept -> bool
+    {
+        return this->m_count == 0;
+    }
+
+    constexpr auto data() const noexcept -> pointer_type
+    {
+        return this->m_data;
+    }
+
+    ///
+    /// Returns reference to element at postion "index"
+    ///
+    constexpr auto operator[](size_type index) const -> reference_type
+    {
+        return this->m_data[index];
+    }
+
+    constexpr auto front() const -> reference_type
+    {
+        return this->m_data[0];
+    }
+
+    constexpr auto back() const -> reference_type
+    {
+        return this->m_data[this->m_count - 1];
+    }
+
+    ///
+    /// View of "count" elements starting at "offset", up to the end by default
+    ///
+    constexpr auto subview(size_type offset, size_type count = npos) const noexcept -> vector_view
+    {
+        offset = std::min(offset, this->m_count);
+        return { this->m_data + offset, std::min(count, this->m_count - offset) };
+    }
+
+    ///
+    /// View of the first "count" elements
+    ///
+    constexpr auto first(size_type count) const noexcept -> vector_view
+    {
+        return { this->m_data, std::min(count, this->m_count) };
+    }
+
+    ///
+    /// View of the last "count" elements
+    ///
+    constexpr auto last(size_type count) const noexcept -> vector_view
+    {
+        count = std::min(count, this->m_count);
+        return { this->m_data + this->m_count - count, count };
+    }
+
+    ///
+    /// Split into the elements before "index" and the ones from "index" on
+    ///
+    constexpr auto split_at(size_type index) const noexcept -> std::pair<vector_view, vector_view>
+    {
+        index = std::min(index, this->m_count);
+        return { vector_view{ this->m_data, index }, vector_view{ this->m_data + index, this->m_count - index } };
+    }
+
+    ///
+    /// Consecutive views of "chunk_size" elements, a chunk_size of 0 is taken as 1
+    ///
+    constexpr auto chunks(size_type chunk_size) const noexcept -> chunk_range<T>
+    {
+        return { *this, std::max<size_type>(chunk_size, 1) };
+    }
+
+    ///
+    /// Returns an iterator to the first viewed element
+    ///
+    auto begin() const -> iterator
+    {
+        return iterator{ this->m_data };
+    }
+
+    ///
+    /// Returns an iterator past the last viewed element
+    ///
+    auto end() const -> iterator
+    {
+        return iterator{ this->m_data + this->m_count };
+    }
+
+private:
+    pointer_type m_data{};
+    size_type m_count{};
+};
+
+///
+/// Consecutive views of "chunk_size" elements covering a view, returned by
+/// vector_view::chunks(). The last one holds the remainder. Meant for range
+/// for loops:
+///
+///     for (kt::vector_view<const int> chunk : kt::vector_view{ values }.chunks(4096))
+///         process(chunk);
+///
+template <typename T>
+class chunk_range
+{
+    using size_type = std::size_t;
+
+public:
+    class iterator
+    {
+    public:
+        using iterator_category     = std::forward_iterator_tag;
+        using value_type            = vector_view<T>;
+        using difference_type       = std::ptrdiff_t;
+        using reference             = vector_view<T>;
+        using pointer               = void;
+
+        constexpr iterator(vector_view<T> rest, size_type chunk_size) noexcept
+            :   m_rest{ rest }, m_chunk_size{ chunk_size }
+        {
+
+        }
+
+        constexpr auto operator*() const noexcept -> vector_view<T>
+        {
+            return this->m_rest.first(this->m_chunk_size);
+        }
+
+        constexpr auto operator++() noexcept -> iterator&
+        {
+            this->m_rest = this->m_rest.subview(this->m_chunk_size);
+            return *this;
+        }
+
+        constexpr auto operator++(int) noexcept -> iterator
+        {
+            iterator copy{ *this };
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const iterator& other) const noexcept -> bool
+        {
+            return this->m_rest.size() == other.m_rest.size();
+        }
+
+        constexpr auto operator!=(const iterator& other) const noexcept -> bool
+        {
+            return not (*this == other);
+        }
+
+    private:
+        vector_view<T> m_rest;
+        size_type m_chunk_size;
+    };
+
+    constexpr chunk_range(vector_view<T> whole, size_type chunk_size) noexcept
+        :   m_whole{ whole }, m_chunk_size{ chunk_size }
+    {
+
+    }
+
+    ///
+    /// Amount of chunks
+    ///
+    constexpr auto size() const noexcept -> size_type
+    {
+        return (this->m_whole.size() + this->m_chunk_size - 1) / this->m_chunk_size;
+    }
+
+    constexpr auto begin() const noexcept -> iterator
+    {
+        return { this->m_whole, this->m_chunk_size };
+    }
+
+    constexpr auto end() const noexcept -> iterator
+    {
+        return { this->m_whole.last(0), this->m_chunk_size };
+    }
+
+private:
+    vector_view<T> m_whole;
+    size_type m_chunk_size;
+};
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+vector_view(vector<T, Alloc, Growth, Errors>&) -> vector_view<T>;
+
+template <typename T, typename Alloc, typename Growth, typename Errors>
+vector_view(const vector<T, Alloc, Growth, Errors>&) -> vector_view<const T>;
+
+///
+/// Shorter name, for code used to std::span
+///
+template <typename T>
+using span = vector_view<T>;
+
+}   // END KT NAMESPACE
+
+#endif